@@ -0,0 +1,108 @@
+#include <parser/lexer.h>
+#include <parser/parser.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace parser;
+
+namespace {
+
+    std::string repeat(std::string_view string, u32 count) {
+        std::string result;
+        result.reserve(string.size() * count);
+        for (u32 i = 0; i < count; ++i)
+            result += string;
+
+        return result;
+    }
+
+    struct Case {
+        std::string name;
+        std::function<std::string(u32)> generate;
+        std::vector<u32> depths;
+    };
+
+    /**
+     * Parses `statements` copies of the generated expression and returns the parse time per token in nanoseconds.
+     */
+    std::optional<double> measure(const std::string &expression, u32 statements) {
+        std::string source;
+        for (u32 i = 0; i < statements; ++i)
+            source += expression + ";";
+
+        Lexer lexer;
+        auto tokens = lexer.lex(source).unwrap();
+
+        // best of a few runs to keep noise out of the ratios
+        double best = 0;
+        for (int run = 0; run < 5; ++run) {
+            Parser parser;
+            auto start = std::chrono::steady_clock::now();
+            auto result = parser.parse(tokens);
+            auto end = std::chrono::steady_clock::now();
+
+            if (result.is_err()) {
+                fmt::print("  parse failed: {}\n", result.unwrap_err()[0].get_message());
+                return std::nullopt;
+            }
+
+            double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / double(tokens.size());
+            if (run == 0 || nanoseconds < best)
+                best = nanoseconds;
+        }
+
+        return best;
+    }
+
+}
+
+int main() {
+    // parentheses and calls are capped by Parser's nesting limit of 1024, cast chains are parsed iteratively
+    std::vector<Case> cases = {
+        { "parentheses ((((a))))", [](u32 depth) { return repeat("(", depth) + "a" + repeat(")", depth); }, { 100, 250, 500, 1000 } },
+        { "parenthesized casts ((u32)((u32)(...a)))", [](u32 depth) { return repeat("((u32)", depth) + "a" + repeat(")", depth); }, { 100, 250, 500, 1000 } },
+        { "cast chain (u32)(s8)...a", [](u32 depth) { return repeat("(u32)(s8)", depth / 2) + "(a)"; }, { 100, 1000, 5000, 20000 } },
+        { "calls f(f(...a))", [](u32 depth) { return repeat("f(", depth) + "a" + repeat(")", depth); }, { 100, 250, 500, 1000 } },
+    };
+
+    constexpr u32 tokensPerCase = 400000;
+    constexpr double maxRatio = 4.0;
+
+    bool linear = true;
+    for (const auto &testCase : cases) {
+        fmt::print("{}\n", testCase.name);
+
+        std::optional<double> baseline;
+        for (u32 depth : testCase.depths) {
+            auto expression = testCase.generate(depth);
+            u32 statements = std::max<u32>(1, tokensPerCase / u32(expression.size()));
+
+            auto nanoseconds = measure(expression, statements);
+            if (!nanoseconds.has_value())
+                return 1;
+
+            if (!baseline.has_value())
+                baseline = nanoseconds;
+
+            double ratio = *nanoseconds / *baseline;
+            fmt::print("  depth {:>6}: {:>7.1f} ns/token ({:.2f}x)\n", depth, *nanoseconds, ratio);
+
+            if (ratio > maxRatio)
+                linear = false;
+        }
+    }
+
+    if (!linear) {
+        fmt::print("time per token grew by more than {}x, parsing is not linear in the nesting depth\n", maxRatio);
+        return 1;
+    }
+
+    return 0;
+}
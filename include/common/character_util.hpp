@@ -1 +1,66 @@
 #pragma once
+
+#include <cctype>
+#include <optional>
+#include <string_view>
+
+namespace util {
+
+    inline std::optional<char> parse_hex_digits(std::string_view input, size_t &cursor, size_t count) {
+        if (cursor + count > input.size())
+            return std::nullopt;
+
+        unsigned value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            char c = input[cursor + i];
+            if (!std::isxdigit(static_cast<unsigned char>(c)))
+                return std::nullopt;
+
+            value = value * 16 + (std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : (std::tolower(c) - 'a' + 10));
+        }
+
+        cursor += count;
+        return static_cast<char>(value);
+    }
+
+    /**
+     * Decodes the escape sequence starting at the backslash in `input[cursor]`.
+     * On success `cursor` is advanced past the sequence.
+     */
+    inline std::optional<char> parse_escape_sequence(std::string_view input, size_t &cursor) {
+        cursor++; // backslash
+        if (cursor >= input.size())
+            return std::nullopt;
+
+        switch (input[cursor++]) {
+            case 'a':
+                return '\a';
+            case 'b':
+                return '\b';
+            case 'f':
+                return '\f';
+            case 'n':
+                return '\n';
+            case 't':
+                return '\t';
+            case 'r':
+                return '\r';
+            case '0':
+                return '\0';
+            case '\'':
+                return '\'';
+            case '\"':
+                return '\"';
+            case '\\':
+                return '\\';
+            case 'x':
+                return parse_hex_digits(input, cursor, 2);
+            case 'u':
+                return parse_hex_digits(input, cursor, 4);
+            default:
+                cursor--;
+                return std::nullopt;
+        }
+    }
+
+}
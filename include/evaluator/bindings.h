@@ -0,0 +1,118 @@
+#pragma once
+#include <common/types.h>
+#include <parser/token.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace evaluator {
+
+    enum class ValueType : u8 {
+        Signed,
+        Unsigned,
+        Float
+    };
+
+    /**
+     * Type both operands of a binary operator are converted to, following C's usual arithmetic conversions.
+     */
+    inline ValueType commonType(ValueType left, ValueType right) {
+        if (left == ValueType::Float || right == ValueType::Float)
+            return ValueType::Float;
+        else if (left == ValueType::Unsigned || right == ValueType::Unsigned)
+            return ValueType::Unsigned;
+        else
+            return ValueType::Signed;
+    }
+
+    /**
+     * Storage of a single variable, laid out so compiled expressions can address it directly.
+     */
+    union Slot {
+        s64 s;
+        u64 u;
+        f64 f;
+    };
+
+    /**
+     * Typed variables an expression is evaluated against.
+     */
+    class Bindings {
+    public:
+        /**
+         * Names and types of the declared variables, shared by all copies of the bindings.
+         */
+        struct Layout {
+            std::vector<std::string> names;
+            std::vector<ValueType> types;
+        };
+
+        Bindings() : m_layout(std::make_shared<Layout>()) { }
+
+        u32 declare(const std::string &name, ValueType type) {
+            // copies and compiled expressions keep referring to the layout they were created with
+            if (m_layout.use_count() > 1)
+                m_layout = std::make_shared<Layout>(*m_layout);
+
+            m_layout->names.push_back(name);
+            m_layout->types.push_back(type);
+            m_slots.push_back({ .u = 0 });
+
+            return u32(m_slots.size() - 1);
+        }
+
+        [[nodiscard]] std::optional<u32> find(std::string_view name) const {
+            for (u32 i = 0; i < m_layout->names.size(); ++i) {
+                if (m_layout->names[i] == name)
+                    return i;
+            }
+
+            return std::nullopt;
+        }
+
+        void set(u32 index, s64 value) { m_slots[index].s = value; }
+        void set(u32 index, u64 value) { m_slots[index].u = value; }
+        void set(u32 index, f64 value) { m_slots[index].f = value; }
+
+        [[nodiscard]] parser::Token::Literal get(u32 index) const {
+            switch (m_layout->types[index]) {
+                case ValueType::Signed:
+                    return m_slots[index].s;
+                case ValueType::Unsigned:
+                    return m_slots[index].u;
+                case ValueType::Float:
+                default:
+                    return m_slots[index].f;
+            }
+        }
+
+        [[nodiscard]] ValueType type(u32 index) const {
+            return m_layout->types[index];
+        }
+
+        [[nodiscard]] const Slot *slots() const {
+            return m_slots.data();
+        }
+
+        [[nodiscard]] std::shared_ptr<const Layout> layout() const {
+            return this->m_layout;
+        }
+
+        /**
+         * Whether the slots line up with `layout`. Layouts compare by identity, so this is constant time,
+         * but bindings that only declare the same variables independently never match.
+         */
+        [[nodiscard]] bool hasLayout(const std::shared_ptr<const Layout> &layout) const {
+            return this->m_layout == layout;
+        }
+
+    private:
+        // only ever modified while no copy shares it, so a layout is identified by its address
+        std::shared_ptr<Layout> m_layout;
+        std::vector<Slot> m_slots;
+    };
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <evaluator/bindings.h>
+#include <parser/ast/ast_node.hpp>
+#include <parser/token.hpp>
+
+#include <common/result.h>
+
+#include <memory>
+#include <optional>
+
+namespace evaluator {
+
+    /**
+     * Tree walking interpreter for expressions.
+     * Integer arithmetic wraps around, shift counts are taken modulo 64 and comparisons as well as logical operators yield an s64 0 or 1.
+     */
+    class Evaluator {
+    public:
+        Evaluator() = default;
+
+        util::ResultOk<parser::Token::Literal> evaluate(const std::shared_ptr<parser::ast::AstNode> &expression, const Bindings &bindings);
+
+        static std::optional<ValueType> typeOf(const parser::Token::Literal &value);
+        static parser::Token::Literal convert(const parser::Token::Literal &value, ValueType type);
+
+    private:
+        util::ResultOk<parser::Token::Literal> evaluate(const parser::ast::AstNode *node);
+        util::ResultOk<parser::Token::Literal> evaluateUnary(parser::Token::Operator op, const parser::Token::Literal &operand);
+        util::ResultOk<parser::Token::Literal> evaluateBinary(parser::Token::Operator op, const parser::Token::Literal &left,
+                                                              const parser::Token::Literal &right);
+        util::ResultOk<parser::Token::Literal> evaluateCast(const std::string &type, const parser::Token::Literal &operand);
+        util::ResultOk<bool> isTrue(const parser::ast::AstNode *node);
+
+        const Bindings *m_bindings = nullptr;
+    };
+
+}
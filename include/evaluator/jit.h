@@ -0,0 +1,160 @@
+#pragma once
+#include <evaluator/bindings.h>
+#include <parser/ast/ast_node.hpp>
+#include <parser/token.hpp>
+
+#include <common/result.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace evaluator {
+
+    /**
+     * Native code of a compiled expression, owns its executable memory.
+     */
+    class JitFunction {
+    public:
+        /**
+         * Returns 0 and writes the result on success, 1 on division by zero.
+         */
+        using Function = u32 (*)(const Slot *slots, Slot *result);
+
+        JitFunction(void *code, size_t size, ValueType resultType) : m_code(code), m_size(size), m_resultType(resultType) { }
+        ~JitFunction();
+
+        JitFunction(const JitFunction &) = delete;
+        JitFunction &operator=(const JitFunction &) = delete;
+
+        JitFunction(JitFunction &&other) noexcept;
+        JitFunction &operator=(JitFunction &&other) noexcept;
+
+        [[nodiscard]] Function function() const {
+            return reinterpret_cast<Function>(this->m_code);
+        }
+
+        [[nodiscard]] ValueType resultType() const {
+            return this->m_resultType;
+        }
+
+        util::ResultOk<parser::Token::Literal> operator()(const Bindings &bindings) const;
+
+    private:
+        void *m_code;
+        size_t m_size;
+        ValueType m_resultType;
+    };
+
+    /**
+     * Compiles expressions to x86-64 machine code.
+     * The generated code follows the same semantics as `Evaluator`.
+     */
+    class Jit {
+    public:
+        Jit() = default;
+
+        /**
+         * Returns std::nullopt if the expression uses anything the backend cannot lower
+         * (strings, casts, member access, function calls, unknown identifiers, ternaries with differently typed branches)
+         * or if the host is not x86-64.
+         */
+        std::optional<JitFunction> compile(const std::shared_ptr<parser::ast::AstNode> &expression, const Bindings &layout);
+
+    private:
+        enum class Opcode : u8 {
+            Constant,
+            Load,
+            Move,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo,
+            ShiftLeft,
+            ShiftRight,
+            And,
+            Or,
+            Xor,
+            Negate,
+            Not,
+            Compare,
+            ToBool,
+            IntToFloat,
+            Jump,
+            JumpIfZero,
+            JumpIfNotZero,
+            Label,
+            Return
+        };
+
+        constexpr static u32 NoRegister = ~0u;
+
+        /**
+         * Three address instruction over virtual registers, `type` is the type of the operands.
+         */
+        struct Instruction {
+            Opcode opcode;
+            ValueType type = ValueType::Signed;
+            parser::Token::Operator condition = parser::Token::Operator::Equal;
+            u32 dst = NoRegister;
+            u32 a = NoRegister;
+            u32 b = NoRegister;
+            u64 immediate = 0;
+        };
+
+        struct Value {
+            u32 reg;
+            ValueType type;
+        };
+
+        struct Location {
+            bool spilled;
+            u8 reg;
+            u32 slot;
+        };
+
+        // lowering
+        std::optional<Value> lower(const parser::ast::AstNode *node);
+        std::optional<Value> lowerBinary(parser::Token::Operator op, const parser::ast::AstNode *left, const parser::ast::AstNode *right);
+        Value convert(Value value, ValueType type);
+        Value toBool(Value value);
+        u32 newRegister(ValueType type);
+        u32 newLabel();
+
+        // register allocation
+        void allocateRegisters();
+
+        // code generation
+        std::vector<u8> generate();
+
+        std::vector<Instruction> m_instructions;
+        std::vector<ValueType> m_registerTypes;
+        std::vector<Location> m_locations;
+        u32 m_labelCount = 0;
+        u32 m_spillSlots = 0;
+        const Bindings *m_layout = nullptr;
+    };
+
+    /**
+     * Expression that runs natively when the JIT supports it and falls back to the interpreter otherwise.
+     * Native code is compiled against the layout of the bindings passed to the constructor, only those
+     * bindings and copies of them that declared no further variables run natively.
+     */
+    class CompiledExpression {
+    public:
+        CompiledExpression(std::shared_ptr<parser::ast::AstNode> expression, const Bindings &layout);
+
+        [[nodiscard]] bool isNative() const {
+            return this->m_native.has_value();
+        }
+
+        util::ResultOk<parser::Token::Literal> evaluate(const Bindings &bindings) const;
+
+    private:
+        std::shared_ptr<parser::ast::AstNode> m_expression;
+        std::shared_ptr<const Bindings::Layout> m_layout;
+        std::optional<JitFunction> m_native;
+    };
+
+}
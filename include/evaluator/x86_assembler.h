@@ -0,0 +1,136 @@
+#pragma once
+#include <common/types.h>
+
+#include <initializer_list>
+#include <vector>
+
+namespace evaluator::x86 {
+
+    enum Register : u8 {
+        rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi,
+        r8, r9, r10, r11, r12, r13, r14, r15
+    };
+
+    enum Xmm : u8 {
+        xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7,
+        xmm8, xmm9, xmm10, xmm11, xmm12, xmm13, xmm14, xmm15
+    };
+
+    enum class Condition : u8 {
+        Overflow, NoOverflow, Below, AboveEqual, Equal, NotEqual, BelowEqual, Above,
+        Sign, NoSign, Parity, NoParity, Less, GreaterEqual, LessEqual, Greater
+    };
+
+    enum class AluOp : u8 {
+        Add = 0x03,
+        Or = 0x0B,
+        And = 0x23,
+        Sub = 0x2B,
+        Xor = 0x33,
+        Cmp = 0x3B
+    };
+
+    enum class UnaryOp : u8 {
+        Not = 2,
+        Neg = 3,
+        Div = 6,
+        IDiv = 7
+    };
+
+    enum class ShiftOp : u8 {
+        Shl = 4,
+        Shr = 5,
+        Sar = 7
+    };
+
+    enum class SseOp : u8 {
+        AddSd = 0x58,
+        MulSd = 0x59,
+        SubSd = 0x5C,
+        DivSd = 0x5E
+    };
+
+    /**
+     * Either a register or a `[base + displacement]` memory reference.
+     */
+    struct Operand {
+        bool memory;
+        u8 reg;
+        s32 displacement;
+
+        static Operand registerOperand(u8 reg) {
+            return { false, reg, 0 };
+        }
+
+        static Operand memoryOperand(u8 base, s32 displacement) {
+            return { true, base, displacement };
+        }
+    };
+
+    /**
+     * Minimal x86-64 encoder for the instructions the JIT emits. All integer operations are 64 bit.
+     */
+    class Assembler {
+    public:
+        Assembler() = default;
+
+        u32 createLabel();
+        void bind(u32 label);
+
+        void mov(Register dst, Operand src);
+        void mov(Operand dst, Register src);
+        void movImmediate(Register dst, u64 immediate);
+        void alu(AluOp op, Register dst, Operand src);
+        void imul(Register dst, Operand src);
+        void unary(UnaryOp op, Operand operand);
+        void shift(ShiftOp op, Register dst);
+        void shiftImmediate(ShiftOp op, Register dst, u8 count);
+        void cmpImmediate(Register dst, s8 immediate);
+        void test(Register left, Register right);
+        void btcImmediate(Register dst, u8 bit);
+        void cqo();
+
+        void setcc(Condition condition, Register dst);
+        void andByte(Register dst, Register src);
+        void orByte(Register dst, Register src);
+        void movzxByte(Register dst, Register src);
+
+        void addRsp(s32 immediate);
+        void subRsp(s32 immediate);
+        void push(Register reg);
+        void pop(Register reg);
+        void ret();
+
+        void jmp(u32 label);
+        void jcc(Condition condition, u32 label);
+
+        void movsd(Xmm dst, Operand src);
+        void movsd(Operand dst, Xmm src);
+        void sse(SseOp op, Xmm dst, Operand src);
+        void ucomisd(Xmm left, Operand right);
+        void xorpd(Xmm dst, Xmm src);
+        void movq(Xmm dst, Register src);
+        void movq(Register dst, Xmm src);
+        void cvtsi2sd(Xmm dst, Register src);
+
+        /**
+         * Resolves all label references and returns the machine code.
+         */
+        std::vector<u8> finish();
+
+    private:
+        void emit(u8 byte);
+        void emit32(u32 value);
+        void emitInstruction(u8 prefix, bool wide, std::initializer_list<u8> opcode, u8 reg, Operand rm);
+
+        struct Fixup {
+            u32 position;
+            u32 label;
+        };
+
+        std::vector<u8> m_code;
+        std::vector<s64> m_labels;
+        std::vector<Fixup> m_fixups;
+    };
+
+}
@@ -1,10 +1,50 @@
 #pragma once
+#include <common/types.h>
+
+#include <string_view>
+
 namespace parser::ast {
 
     class AstNode {
     public:
         AstNode() = default;
         virtual ~AstNode() = default;
+
+        /**
+         * Structural hash of the subtree, equal for structurally identical subtrees and stable across runs.
+         */
+        [[nodiscard]] u64 hash() const {
+            return this->m_hash;
+        }
+
+        /**
+         * Compares node type and payload, children are compared by identity.
+         * Once children are deduplicated this is full structural equality.
+         */
+        [[nodiscard]] virtual bool shallowEquals(const AstNode &other) const = 0;
+
+    protected:
+        constexpr static u64 hashString(std::string_view string) {
+            // FNV-1a
+            u64 hash = 0xCBF29CE484222325;
+            for (char c : string) {
+                hash ^= u8(c);
+                hash *= 0x100000001B3;
+            }
+
+            return hash;
+        }
+
+        constexpr static u64 combineHash(u64 seed, u64 value) {
+            u64 hash = seed ^ (value + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2));
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCD;
+            hash ^= hash >> 33;
+
+            return hash;
+        }
+
+        u64 m_hash{};
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+#include <parser/token.hpp>
+
+#include <cassert>
+#include <memory>
+
+namespace parser::ast {
+
+    class AstNodeBinaryOperator : public AstNode {
+    public:
+        AstNodeBinaryOperator(Token::Operator op, std::shared_ptr<AstNode> left, std::shared_ptr<AstNode> right)
+            : m_operator(op), m_left(std::move(left)), m_right(std::move(right)) {
+            assert(m_left != nullptr);
+            assert(m_right != nullptr);
+            m_hash = combineHash(combineHash(combineHash(Kind, u64(m_operator)), m_left->hash()), m_right->hash());
+        }
+
+        [[nodiscard]] Token::Operator getOperator() const {
+            return this->m_operator;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &left() const {
+            return this->m_left;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &right() const {
+            return this->m_right;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto binary = dynamic_cast<const AstNodeBinaryOperator *>(&other);
+            return binary != nullptr && binary->m_operator == m_operator && binary->m_left == m_left && binary->m_right == m_right;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("binary_operator");
+
+        Token::Operator m_operator;
+        std::shared_ptr<AstNode> m_left;
+        std::shared_ptr<AstNode> m_right;
+    };
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+namespace parser::ast {
+
+    class AstNodeCast : public AstNode {
+    public:
+        AstNodeCast(std::string type, std::shared_ptr<AstNode> operand)
+            : m_type(std::move(type)), m_operand(std::move(operand)) {
+            assert(m_operand != nullptr);
+            m_hash = combineHash(combineHash(Kind, hashString(m_type)), m_operand->hash());
+        }
+
+        [[nodiscard]] const std::string &type() const {
+            return this->m_type;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &operand() const {
+            return this->m_operand;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto cast = dynamic_cast<const AstNodeCast *>(&other);
+            return cast != nullptr && cast->m_type == m_type && cast->m_operand == m_operand;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("cast");
+
+        std::string m_type;
+        std::shared_ptr<AstNode> m_operand;
+    };
+
+}
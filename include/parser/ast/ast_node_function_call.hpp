@@ -0,0 +1,42 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace parser::ast {
+
+    class AstNodeFunctionCall : public AstNode {
+    public:
+        AstNodeFunctionCall(std::string name, std::vector<std::shared_ptr<AstNode>> arguments)
+            : m_name(std::move(name)), m_arguments(std::move(arguments)) {
+            m_hash = combineHash(combineHash(Kind, hashString(m_name)), m_arguments.size());
+            for (const auto &argument : m_arguments) {
+                assert(argument != nullptr);
+                m_hash = combineHash(m_hash, argument->hash());
+            }
+        }
+
+        [[nodiscard]] const std::string &name() const {
+            return this->m_name;
+        }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<AstNode>> &arguments() const {
+            return this->m_arguments;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto call = dynamic_cast<const AstNodeFunctionCall *>(&other);
+            return call != nullptr && call->m_name == m_name && call->m_arguments == m_arguments;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("function_call");
+
+        std::string m_name;
+        std::vector<std::shared_ptr<AstNode>> m_arguments;
+    };
+
+}
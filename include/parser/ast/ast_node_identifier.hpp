@@ -0,0 +1,29 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <string>
+
+namespace parser::ast {
+
+    class AstNodeIdentifier : public AstNode {
+    public:
+        explicit AstNodeIdentifier(std::string name) : m_name(std::move(name)) {
+            m_hash = combineHash(Kind, hashString(m_name));
+        }
+
+        [[nodiscard]] const std::string &name() const {
+            return this->m_name;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto identifier = dynamic_cast<const AstNodeIdentifier *>(&other);
+            return identifier != nullptr && identifier->m_name == m_name;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("identifier");
+
+        std::string m_name;
+    };
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+#include <parser/token.hpp>
+
+#include <bit>
+
+namespace parser::ast {
+
+    class AstNodeLiteral : public AstNode {
+    public:
+        explicit AstNodeLiteral(Token::Literal literal) : m_literal(std::move(literal)) {
+            m_hash = combineHash(combineHash(Kind, m_literal.index()), std::visit([](const auto &value) -> u64 {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, Token::String>)
+                    return combineHash(hashString(value.raw()), value.hasEscapes());
+                else
+                    return std::bit_cast<u64>(value);
+            }, m_literal));
+        }
+
+        [[nodiscard]] const Token::Literal &literal() const {
+            return this->m_literal;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto literal = dynamic_cast<const AstNodeLiteral *>(&other);
+            if (literal == nullptr || literal->m_literal.index() != m_literal.index())
+                return false;
+
+            // floats compare by bits, so 0.0 and -0.0 stay distinct and NaN equals itself
+            // strings compare by spelling like their hash, so interning never has to decode them
+            return std::visit([&](const auto &value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, Token::String>) {
+                    const auto &other = std::get<T>(literal->m_literal);
+                    return value.raw() == other.raw() && value.hasEscapes() == other.hasEscapes();
+                } else {
+                    return std::bit_cast<u64>(value) == std::bit_cast<u64>(std::get<T>(literal->m_literal));
+                }
+            }, m_literal);
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("literal");
+
+        Token::Literal m_literal;
+    };
+
+}
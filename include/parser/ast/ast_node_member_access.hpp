@@ -0,0 +1,38 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+namespace parser::ast {
+
+    class AstNodeMemberAccess : public AstNode {
+    public:
+        AstNodeMemberAccess(std::shared_ptr<AstNode> object, std::string member)
+            : m_object(std::move(object)), m_member(std::move(member)) {
+            assert(m_object != nullptr);
+            m_hash = combineHash(combineHash(Kind, m_object->hash()), hashString(m_member));
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &object() const {
+            return this->m_object;
+        }
+
+        [[nodiscard]] const std::string &member() const {
+            return this->m_member;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto access = dynamic_cast<const AstNodeMemberAccess *>(&other);
+            return access != nullptr && access->m_object == m_object && access->m_member == m_member;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("member_access");
+
+        std::shared_ptr<AstNode> m_object;
+        std::string m_member;
+    };
+
+}
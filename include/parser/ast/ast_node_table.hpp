@@ -0,0 +1,75 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace parser::ast {
+
+    /**
+     * Hash-consing table mapping structurally identical subtrees to one shared node, turning trees into a DAG.
+     * Nodes have to be interned bottom up, so their children are already unique when they are looked up.
+     * Safe to use from multiple threads.
+     * Interned nodes are only released by `clear`, so the table keeps every subtree it has seen alive.
+     */
+    class AstNodeTable {
+    public:
+        AstNodeTable() = default;
+
+        /**
+         * Returns the existing node structurally equal to `node`, or adds `node` to the table.
+         */
+        std::shared_ptr<AstNode> intern(std::shared_ptr<AstNode> node) {
+            auto &shard = m_shards[node->hash() % ShardCount];
+
+            std::scoped_lock lock(shard.mutex);
+            return *shard.nodes.insert(std::move(node)).first;
+        }
+
+        /**
+         * Releases all interned nodes. Must not race with `intern`.
+         */
+        void clear() {
+            for (auto &shard : m_shards) {
+                std::scoped_lock lock(shard.mutex);
+                shard.nodes.clear();
+            }
+        }
+
+        [[nodiscard]] size_t size() const {
+            size_t size = 0;
+            for (auto &shard : m_shards) {
+                std::scoped_lock lock(shard.mutex);
+                size += shard.nodes.size();
+            }
+
+            return size;
+        }
+
+    private:
+        struct Hash {
+            size_t operator()(const std::shared_ptr<AstNode> &node) const {
+                return node->hash();
+            }
+        };
+
+        struct Equal {
+            bool operator()(const std::shared_ptr<AstNode> &left, const std::shared_ptr<AstNode> &right) const {
+                return left->hash() == right->hash() && left->shallowEquals(*right);
+            }
+        };
+
+        // sharded by hash so parallel parsers rarely contend on the same lock
+        constexpr static size_t ShardCount = 64;
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_set<std::shared_ptr<AstNode>, Hash, Equal> nodes;
+        };
+
+        std::array<Shard, ShardCount> m_shards;
+    };
+
+}
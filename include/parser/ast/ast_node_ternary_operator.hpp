@@ -0,0 +1,45 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+
+#include <cassert>
+#include <memory>
+
+namespace parser::ast {
+
+    class AstNodeTernaryOperator : public AstNode {
+    public:
+        AstNodeTernaryOperator(std::shared_ptr<AstNode> condition, std::shared_ptr<AstNode> trueBranch, std::shared_ptr<AstNode> falseBranch)
+            : m_condition(std::move(condition)), m_trueBranch(std::move(trueBranch)), m_falseBranch(std::move(falseBranch)) {
+            assert(m_condition != nullptr);
+            assert(m_trueBranch != nullptr);
+            assert(m_falseBranch != nullptr);
+            m_hash = combineHash(combineHash(combineHash(Kind, m_condition->hash()), m_trueBranch->hash()), m_falseBranch->hash());
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &condition() const {
+            return this->m_condition;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &trueBranch() const {
+            return this->m_trueBranch;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &falseBranch() const {
+            return this->m_falseBranch;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto ternary = dynamic_cast<const AstNodeTernaryOperator *>(&other);
+            return ternary != nullptr && ternary->m_condition == m_condition
+                && ternary->m_trueBranch == m_trueBranch && ternary->m_falseBranch == m_falseBranch;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("ternary_operator");
+
+        std::shared_ptr<AstNode> m_condition;
+        std::shared_ptr<AstNode> m_trueBranch;
+        std::shared_ptr<AstNode> m_falseBranch;
+    };
+
+}
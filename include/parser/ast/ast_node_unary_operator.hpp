@@ -0,0 +1,38 @@
+#pragma once
+#include <parser/ast/ast_node.hpp>
+#include <parser/token.hpp>
+
+#include <cassert>
+#include <memory>
+
+namespace parser::ast {
+
+    class AstNodeUnaryOperator : public AstNode {
+    public:
+        AstNodeUnaryOperator(Token::Operator op, std::shared_ptr<AstNode> operand)
+            : m_operator(op), m_operand(std::move(operand)) {
+            assert(m_operand != nullptr);
+            m_hash = combineHash(combineHash(Kind, u64(m_operator)), m_operand->hash());
+        }
+
+        [[nodiscard]] Token::Operator getOperator() const {
+            return this->m_operator;
+        }
+
+        [[nodiscard]] const std::shared_ptr<AstNode> &operand() const {
+            return this->m_operand;
+        }
+
+        [[nodiscard]] bool shallowEquals(const AstNode &other) const override {
+            auto unary = dynamic_cast<const AstNodeUnaryOperator *>(&other);
+            return unary != nullptr && unary->m_operator == m_operator && unary->m_operand == m_operand;
+        }
+
+    private:
+        constexpr static u64 Kind = hashString("unary_operator");
+
+        Token::Operator m_operator;
+        std::shared_ptr<AstNode> m_operand;
+    };
+
+}
@@ -25,6 +25,10 @@ namespace parser {
     public:
         Lexer() = default;
 
+        /**
+         * String literal tokens reference the lexer's copy of the source code,
+         * they stay valid until the lexer is destroyed or `lex` is called again.
+         */
         util::Results<std::vector<Token>> lex(const std::string &sourceCode);
 
     private:
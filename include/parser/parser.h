@@ -1,13 +1,22 @@
 #pragma once
 #include <parser/token.hpp>
+#include <parser/lexer.h>
 #include <parser/ast/ast_node.hpp>
+#include <parser/ast/ast_node_table.hpp>
 
 #include <common/result.h>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <initializer_list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <span>
 
 namespace parser {
 
@@ -15,22 +24,148 @@ namespace parser {
     public:
         using Iterator = std::vector<Token>::const_iterator;
 
+        /**
+         * Token range of a single top-level statement, including its terminating semicolon if present.
+         */
+        struct StatementRange {
+            Iterator begin;
+            Iterator end;
+        };
+
         Parser() = default;
         ~Parser() = default;
 
         util::Results<std::vector<std::shared_ptr<ast::AstNode>>> parse(const std::vector<Token>& tokens);
 
+        /**
+         * Parses the top-level statements on up to `threadCount` threads.
+         * Nodes are returned in source order and errors are identical to those reported by `parse`.
+         */
+        util::Results<std::vector<std::shared_ptr<ast::AstNode>>> parseParallel(const std::vector<Token>& tokens, u32 threadCount = 0);
+
+        /**
+         * Splits the tokens at every semicolon, including ones inside unclosed brackets.
+         * No expression can contain a semicolon, so an unbalanced bracket is reported by the statement it was
+         * opened in and never swallows the statements after it.
+         */
+        static std::vector<StatementRange> findStatementBoundaries(const std::vector<Token>& tokens);
+
+        /**
+         * Deduplicates structurally identical subtrees while parsing, so the result is a DAG of shared nodes.
+         * The table is cleared at the start of every `parse`, since interned string literals point into the
+         * lexer that produced them and must not be compared against tokens of a later source.
+         */
+        void enableHashConsing() {
+            if (m_nodeTable == nullptr)
+                m_nodeTable = std::make_shared<ast::AstNodeTable>();
+        }
+
+        [[nodiscard]] const std::shared_ptr<ast::AstNodeTable> &nodeTable() const {
+            return m_nodeTable;
+        }
+
+        /**
+         * Makes `(name)` parse as a cast instead of a parenthesized expression.
+         */
+        void addTypeName(const std::string& name) {
+            m_typeNames.insert(name);
+        }
+
     private:
         // parser functions
+        void parseStatements(std::span<const StatementRange> statements);
+        std::shared_ptr<ast::AstNode> parseStatement(const StatementRange& statement);
+
+        std::shared_ptr<ast::AstNode> parseExpression();
+        std::shared_ptr<ast::AstNode> parseTernaryExpression();
+        std::shared_ptr<ast::AstNode> parseOrExpression();
+        std::shared_ptr<ast::AstNode> parseBoolXorExpression();
+        std::shared_ptr<ast::AstNode> parseAndExpression();
+        std::shared_ptr<ast::AstNode> parseEqualityExpression();
+        std::shared_ptr<ast::AstNode> parseRelationalExpression();
+        std::shared_ptr<ast::AstNode> parseBinaryOrExpression();
+        std::shared_ptr<ast::AstNode> parseBinaryXorExpression();
+        std::shared_ptr<ast::AstNode> parseBinaryAndExpression();
+        std::shared_ptr<ast::AstNode> parseShiftExpression();
+        std::shared_ptr<ast::AstNode> parseAdditiveExpression();
+        std::shared_ptr<ast::AstNode> parseMultiplicativeExpression();
+        std::shared_ptr<ast::AstNode> parseBinaryExpression(std::shared_ptr<ast::AstNode> (Parser::*parseOperand)(),
+                                                            std::initializer_list<Token::Operator> operators);
+        std::shared_ptr<ast::AstNode> parseUnaryExpression();
+        std::shared_ptr<ast::AstNode> parseCastExpression();
+        std::shared_ptr<ast::AstNode> parseFactor();
+        std::shared_ptr<ast::AstNode> parseMemberAccess(std::shared_ptr<ast::AstNode> object);
+        std::shared_ptr<ast::AstNode> parseFunctionCall(const std::string& name);
+
+        // token helpers
+        [[nodiscard]] inline bool atEnd() const {
+            return m_current == m_end;
+        }
+
+        [[nodiscard]] inline bool peek(const Token& token) const {
+            return !atEnd() && m_current->type() == token.type() && m_current->value() == token.value();
+        }
+
+        [[nodiscard]] inline bool peek(Token::Type type) const {
+            return !atEnd() && m_current->type() == type;
+        }
+
+        [[nodiscard]] inline std::optional<Token::Operator> peekOperator(std::initializer_list<Token::Operator> operators) const {
+            if (!peek(Token::Type::Operator))
+                return std::nullopt;
+
+            auto op = std::get<Token::Operator>(m_current->value());
+            if (std::find(operators.begin(), operators.end(), op) == operators.end())
+                return std::nullopt;
+
+            return op;
+        }
+
+        inline bool consume(const Token& token) {
+            if (!peek(token))
+                return false;
+
+            m_current++;
+            return true;
+        }
+
+        template<typename T, typename... Args>
+        inline std::shared_ptr<ast::AstNode> create(Args&&... args) {
+            auto node = std::make_shared<T>(std::forward<Args>(args)...);
+            if (m_nodeTable != nullptr)
+                return m_nodeTable->intern(std::move(node));
+
+            return node;
+        }
+
+        [[nodiscard]] bool isCast() const;
+
+        [[nodiscard]] Location currentLocation() const;
+
+        template<typename... Args>
+        inline std::shared_ptr<ast::AstNode> error(fmt::format_string<Args...> fmt, Args&&... args) {
+            m_errors.emplace_back(fmt::format(fmt, std::forward<Args>(args)...), currentLocation());
+            return nullptr;
+        }
+
+        constexpr static u32 maxNestingDepth = 1024;
 
         // state
+        Iterator m_begin;
         Iterator m_current;
-        Iterator m_resetPoint;
+        Iterator m_end;
+        u32 m_depth{};
+
+        std::set<std::string, std::less<>> m_typeNames = {
+            "u8", "u16", "u32", "u64",
+            "s8", "s16", "s32", "s64",
+            "f32", "f64"
+        };
 
-        std::vector<Token> m_tokens;
-        std::vector<util::Error> m_errors;
+        std::vector<ParserError> m_errors;
         std::vector<std::shared_ptr<ast::AstNode>> m_ast;
+        std::shared_ptr<ast::AstNodeTable> m_nodeTable;
 
     };
 
-}
\ No newline at end of file
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <common/types.h>
+#include <cassert>
 #include <variant>
 #include <string>
+#include <string_view>
 #include <map>
 
 namespace parser {
@@ -36,7 +38,26 @@ namespace parser {
             Minus,
             Multiply,
             Divide,
+            Modulo,
             Assign,
+            LeftShift,
+            RightShift,
+            BitAnd,
+            BitOr,
+            BitXor,
+            BitNot,
+            BoolNot,
+            BoolAnd,
+            BoolOr,
+            BoolXor,
+            Equal,
+            NotEqual,
+            Less,
+            Greater,
+            LessEqual,
+            GreaterEqual,
+            QuestionMark,
+            Colon
         };
 
         enum class Separator : u8 {
@@ -63,7 +84,35 @@ namespace parser {
             std::string m_identifier;
         };
 
-        using Literal = std::variant<std::string, s64, u64, f64>;
+        /**
+         * A string literal as it appears in the source, without the surrounding quotes.
+         * The span points into the source code passed to the lexer, escape sequences are only decoded on demand.
+         */
+        struct String {
+            String(std::string_view raw, bool hasEscapes) : m_raw(raw), m_hasEscapes(hasEscapes) { }
+
+            [[nodiscard]] std::string_view raw() const { return this->m_raw; }
+
+            [[nodiscard]] bool hasEscapes() const { return this->m_hasEscapes; }
+
+            /**
+             * Zero-copy view of the string contents, only valid if the literal has no escape sequences.
+             */
+            [[nodiscard]] std::string_view view() const {
+                assert(!this->m_hasEscapes && "escaped string literals have to be decoded");
+                return this->m_raw;
+            }
+
+            [[nodiscard]] std::string decode() const;
+
+            bool operator==(const String &other) const;
+
+        private:
+            std::string_view m_raw;
+            bool m_hasEscapes;
+        };
+
+        using Literal = std::variant<String, s64, u64, f64>;
 
         using Value = std::variant<Keyword, Identifier, Operator, Separator, Literal>;
 
@@ -73,7 +122,7 @@ namespace parser {
             return this->m_type;
         }
 
-        [[nodiscard]] inline Value value() const {
+        [[nodiscard]] inline const Value &value() const {
             return this->m_value;
         }
 
@@ -117,7 +166,7 @@ namespace parser {
 
         namespace Operator {
 
-            constexpr static u8 maxOperatorLength = 1;
+            constexpr static u8 maxOperatorLength = 2;
 
             inline Token makeOperator(const Token::Value& value, const std::string &name) {
                 auto token = makeToken(Token::Type::Operator, value);
@@ -129,7 +178,26 @@ namespace parser {
             const auto Minus = makeOperator(Token::Operator::Minus, "-");
             const auto Multiply = makeOperator(Token::Operator::Multiply, "*");
             const auto Divide = makeOperator(Token::Operator::Divide, "/");
+            const auto Modulo = makeOperator(Token::Operator::Modulo, "%");
             const auto Assign = makeOperator(Token::Operator::Assign, "=");
+            const auto LeftShift = makeOperator(Token::Operator::LeftShift, "<<");
+            const auto RightShift = makeOperator(Token::Operator::RightShift, ">>");
+            const auto BitAnd = makeOperator(Token::Operator::BitAnd, "&");
+            const auto BitOr = makeOperator(Token::Operator::BitOr, "|");
+            const auto BitXor = makeOperator(Token::Operator::BitXor, "^");
+            const auto BitNot = makeOperator(Token::Operator::BitNot, "~");
+            const auto BoolNot = makeOperator(Token::Operator::BoolNot, "!");
+            const auto BoolAnd = makeOperator(Token::Operator::BoolAnd, "&&");
+            const auto BoolOr = makeOperator(Token::Operator::BoolOr, "||");
+            const auto BoolXor = makeOperator(Token::Operator::BoolXor, "^^");
+            const auto Equal = makeOperator(Token::Operator::Equal, "==");
+            const auto NotEqual = makeOperator(Token::Operator::NotEqual, "!=");
+            const auto Less = makeOperator(Token::Operator::Less, "<");
+            const auto Greater = makeOperator(Token::Operator::Greater, ">");
+            const auto LessEqual = makeOperator(Token::Operator::LessEqual, "<=");
+            const auto GreaterEqual = makeOperator(Token::Operator::GreaterEqual, ">=");
+            const auto QuestionMark = makeOperator(Token::Operator::QuestionMark, "?");
+            const auto Colon = makeOperator(Token::Operator::Colon, ":");
 
         }
 
@@ -161,8 +229,8 @@ namespace parser {
                 return makeToken(Token::Type::Identifier, { Token::Identifier(identifier) });
             }
 
-            inline Token makeString(const std::string &string) {
-                return makeToken(Token::Type::String, { string });
+            inline Token makeString(const Token::String &string) {
+                return makeToken(Token::Type::String, Token::Literal { string });
             }
 
             inline Token makeNumeric(const Token::Value& value) {
@@ -0,0 +1,314 @@
+#include "evaluator/evaluator.h"
+#include "parser/ast/ast_node_literal.hpp"
+#include "parser/ast/ast_node_identifier.hpp"
+#include "parser/ast/ast_node_unary_operator.hpp"
+#include "parser/ast/ast_node_binary_operator.hpp"
+#include "parser/ast/ast_node_ternary_operator.hpp"
+#include "parser/ast/ast_node_cast.hpp"
+
+#include <fmt/format.h>
+
+#include <cmath>
+
+using namespace evaluator;
+using namespace parser;
+using namespace util;
+
+using Literal = Token::Literal;
+
+std::optional<ValueType> Evaluator::typeOf(const Literal &value) {
+    if (std::holds_alternative<s64>(value))
+        return ValueType::Signed;
+    else if (std::holds_alternative<u64>(value))
+        return ValueType::Unsigned;
+    else if (std::holds_alternative<f64>(value))
+        return ValueType::Float;
+    else
+        return std::nullopt;
+}
+
+Literal Evaluator::convert(const Literal &value, ValueType type) {
+    return std::visit([type](auto value) -> Literal {
+        using T = decltype(value);
+        if constexpr (std::is_same_v<T, Token::String>) {
+            return value;
+        } else {
+            switch (type) {
+                case ValueType::Signed:
+                    return static_cast<s64>(value);
+                case ValueType::Unsigned:
+                    return static_cast<u64>(value);
+                case ValueType::Float:
+                default:
+                    return static_cast<f64>(value);
+            }
+        }
+    }, value);
+}
+
+static bool isTrueValue(const Literal &value) {
+    if (auto *f = std::get_if<f64>(&value))
+        return *f != 0.0;
+    else if (auto *s = std::get_if<s64>(&value))
+        return *s != 0;
+    else
+        return std::get<u64>(value) != 0;
+}
+
+template<typename T>
+static Literal compare(Token::Operator op, T left, T right) {
+    switch (op) {
+        case Token::Operator::Equal:
+            return s64(left == right);
+        case Token::Operator::NotEqual:
+            return s64(left != right);
+        case Token::Operator::Less:
+            return s64(left < right);
+        case Token::Operator::Greater:
+            return s64(left > right);
+        case Token::Operator::LessEqual:
+            return s64(left <= right);
+        case Token::Operator::GreaterEqual:
+        default:
+            return s64(left >= right);
+    }
+}
+
+ResultOk<Literal> Evaluator::evaluateUnary(Token::Operator op, const Literal &operand) {
+    auto type = typeOf(operand);
+    if (!type.has_value())
+        return Error("Invalid operand to unary operator");
+
+    switch (op) {
+        case Token::Operator::Plus:
+            return operand;
+        case Token::Operator::Minus:
+            if (*type == ValueType::Float)
+                return Literal(-std::get<f64>(operand));
+
+            // negate in unsigned arithmetic so s64 minimum wraps instead of overflowing
+            return convert(Literal(u64(0) - std::get<u64>(convert(operand, ValueType::Unsigned))), *type);
+        case Token::Operator::BitNot:
+            if (*type == ValueType::Float)
+                return Error("Invalid operand to '~'");
+
+            return convert(Literal(~std::get<u64>(convert(operand, ValueType::Unsigned))), *type);
+        case Token::Operator::BoolNot:
+            return Literal(s64(!isTrueValue(operand)));
+        default:
+            return Error("Invalid unary operator");
+    }
+}
+
+ResultOk<Literal> Evaluator::evaluateBinary(Token::Operator op, const Literal &left, const Literal &right) {
+    auto leftType = typeOf(left), rightType = typeOf(right);
+    if (!leftType.has_value() || !rightType.has_value())
+        return Error("Invalid operands to binary operator");
+
+    if (op == Token::Operator::BoolXor)
+        return Literal(s64(isTrueValue(left) != isTrueValue(right)));
+
+    // shifts keep the type of the left operand
+    if (op == Token::Operator::LeftShift || op == Token::Operator::RightShift) {
+        if (*leftType == ValueType::Float || *rightType == ValueType::Float)
+            return Error("Invalid operands to shift");
+
+        u64 count = std::get<u64>(convert(right, ValueType::Unsigned)) & 63;
+        if (op == Token::Operator::LeftShift)
+            return convert(Literal(std::get<u64>(convert(left, ValueType::Unsigned)) << count), *leftType);
+        else if (*leftType == ValueType::Signed)
+            return Literal(std::get<s64>(left) >> count);
+        else
+            return Literal(std::get<u64>(left) >> count);
+    }
+
+    auto type = commonType(*leftType, *rightType);
+    auto a = convert(left, type), b = convert(right, type);
+
+    switch (op) {
+        case Token::Operator::Equal:
+        case Token::Operator::NotEqual:
+        case Token::Operator::Less:
+        case Token::Operator::Greater:
+        case Token::Operator::LessEqual:
+        case Token::Operator::GreaterEqual:
+            switch (type) {
+                case ValueType::Signed:
+                    return compare(op, std::get<s64>(a), std::get<s64>(b));
+                case ValueType::Unsigned:
+                    return compare(op, std::get<u64>(a), std::get<u64>(b));
+                case ValueType::Float:
+                default:
+                    return compare(op, std::get<f64>(a), std::get<f64>(b));
+            }
+        default:
+            break;
+    }
+
+    if (type == ValueType::Float) {
+        f64 x = std::get<f64>(a), y = std::get<f64>(b);
+        switch (op) {
+            case Token::Operator::Plus:
+                return Literal(x + y);
+            case Token::Operator::Minus:
+                return Literal(x - y);
+            case Token::Operator::Multiply:
+                return Literal(x * y);
+            case Token::Operator::Divide:
+                return Literal(x / y);
+            default:
+                return Error("Invalid operands to binary operator");
+        }
+    }
+
+    // signed and unsigned arithmetic share their bit patterns, only division differs
+    u64 x = std::get<u64>(convert(a, ValueType::Unsigned)), y = std::get<u64>(convert(b, ValueType::Unsigned));
+    switch (op) {
+        case Token::Operator::Plus:
+            return convert(Literal(x + y), type);
+        case Token::Operator::Minus:
+            return convert(Literal(x - y), type);
+        case Token::Operator::Multiply:
+            return convert(Literal(x * y), type);
+        case Token::Operator::BitAnd:
+            return convert(Literal(x & y), type);
+        case Token::Operator::BitOr:
+            return convert(Literal(x | y), type);
+        case Token::Operator::BitXor:
+            return convert(Literal(x ^ y), type);
+        case Token::Operator::Divide:
+        case Token::Operator::Modulo: {
+            if (y == 0)
+                return Error("Division by zero");
+
+            bool divide = op == Token::Operator::Divide;
+            if (type == ValueType::Unsigned)
+                return Literal(divide ? x / y : x % y);
+
+            // s64 minimum / -1 wraps around instead of trapping
+            if (s64(y) == -1)
+                return Literal(divide ? s64(u64(0) - x) : s64(0));
+
+            return Literal(divide ? s64(x) / s64(y) : s64(x) % s64(y));
+        }
+        default:
+            return Error("Invalid binary operator");
+    }
+}
+
+ResultOk<Literal> Evaluator::evaluateCast(const std::string &type, const Literal &operand) {
+    auto operandType = typeOf(operand);
+    if (!operandType.has_value())
+        return Error(fmt::format("Cannot cast to '{}'", type));
+
+    if (type == "f64")
+        return convert(operand, ValueType::Float);
+    if (type == "f32")
+        return Literal(f64(f32(std::get<f64>(convert(operand, ValueType::Float)))));
+
+    if (*operandType == ValueType::Float) {
+        f64 value = std::get<f64>(operand);
+        if (std::isnan(value) || value < -0x1p63 || value >= 0x1p64)
+            return Error(fmt::format("Value out of range for '{}'", type));
+    }
+
+    u64 value = *operandType == ValueType::Float && std::get<f64>(operand) >= 0x1p63
+            ? static_cast<u64>(std::get<f64>(operand))
+            : u64(std::get<s64>(convert(operand, ValueType::Signed)));
+
+    if (type == "u8") return Literal(u64(u8(value)));
+    if (type == "u16") return Literal(u64(u16(value)));
+    if (type == "u32") return Literal(u64(u32(value)));
+    if (type == "u64") return Literal(value);
+    if (type == "s8") return Literal(s64(static_cast<signed char>(value)));
+    if (type == "s16") return Literal(s64(s16(value)));
+    if (type == "s32") return Literal(s64(s32(value)));
+    if (type == "s64") return Literal(s64(value));
+
+    return Error(fmt::format("Unknown type '{}'", type));
+}
+
+ResultOk<bool> Evaluator::isTrue(const ast::AstNode *node) {
+    auto value = evaluate(node);
+    if (value.is_err())
+        return value.unwrap_err();
+
+    if (!typeOf(value.unwrap()).has_value())
+        return Error("Invalid operand in condition");
+
+    return isTrueValue(value.unwrap());
+}
+
+ResultOk<Literal> Evaluator::evaluate(const ast::AstNode *node) {
+    if (auto literal = dynamic_cast<const ast::AstNodeLiteral *>(node)) {
+        return literal->literal();
+    }
+
+    if (auto identifier = dynamic_cast<const ast::AstNodeIdentifier *>(node)) {
+        auto index = m_bindings->find(identifier->name());
+        if (!index.has_value())
+            return Error(fmt::format("Unknown identifier '{}'", identifier->name()));
+
+        return m_bindings->get(*index);
+    }
+
+    if (auto unary = dynamic_cast<const ast::AstNodeUnaryOperator *>(node)) {
+        auto operand = evaluate(unary->operand().get());
+        if (operand.is_err())
+            return operand;
+
+        return evaluateUnary(unary->getOperator(), operand.unwrap());
+    }
+
+    if (auto binary = dynamic_cast<const ast::AstNodeBinaryOperator *>(node)) {
+        // logical and / or short circuit
+        if (binary->getOperator() == Token::Operator::BoolAnd || binary->getOperator() == Token::Operator::BoolOr) {
+            bool isOr = binary->getOperator() == Token::Operator::BoolOr;
+
+            auto left = isTrue(binary->left().get());
+            if (left.is_err())
+                return left.unwrap_err();
+            if (left.unwrap() == isOr)
+                return Literal(s64(isOr));
+
+            auto right = isTrue(binary->right().get());
+            if (right.is_err())
+                return right.unwrap_err();
+
+            return Literal(s64(right.unwrap()));
+        }
+
+        auto left = evaluate(binary->left().get());
+        if (left.is_err())
+            return left;
+
+        auto right = evaluate(binary->right().get());
+        if (right.is_err())
+            return right;
+
+        return evaluateBinary(binary->getOperator(), left.unwrap(), right.unwrap());
+    }
+
+    if (auto ternary = dynamic_cast<const ast::AstNodeTernaryOperator *>(node)) {
+        auto condition = isTrue(ternary->condition().get());
+        if (condition.is_err())
+            return condition.unwrap_err();
+
+        return evaluate(condition.unwrap() ? ternary->trueBranch().get() : ternary->falseBranch().get());
+    }
+
+    if (auto cast = dynamic_cast<const ast::AstNodeCast *>(node)) {
+        auto operand = evaluate(cast->operand().get());
+        if (operand.is_err())
+            return operand;
+
+        return evaluateCast(cast->type(), operand.unwrap());
+    }
+
+    return Error("Unsupported expression");
+}
+
+ResultOk<Literal> Evaluator::evaluate(const std::shared_ptr<ast::AstNode> &expression, const Bindings &bindings) {
+    m_bindings = &bindings;
+    return evaluate(expression.get());
+}
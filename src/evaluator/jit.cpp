@@ -0,0 +1,696 @@
+#include "evaluator/jit.h"
+#include "evaluator/evaluator.h"
+#include "evaluator/x86_assembler.h"
+#include "parser/ast/ast_node_literal.hpp"
+#include "parser/ast/ast_node_identifier.hpp"
+#include "parser/ast/ast_node_unary_operator.hpp"
+#include "parser/ast/ast_node_binary_operator.hpp"
+#include "parser/ast/ast_node_ternary_operator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && defined(__unix__)
+    #define BOOTSTRAP_JIT_SUPPORTED
+    #include <sys/mman.h>
+#endif
+
+using namespace evaluator;
+using namespace evaluator::x86;
+using namespace parser;
+using namespace util;
+
+// JitFunction
+
+JitFunction::~JitFunction() {
+#if defined(BOOTSTRAP_JIT_SUPPORTED)
+    if (m_code != nullptr)
+        munmap(m_code, m_size);
+#endif
+}
+
+JitFunction::JitFunction(JitFunction &&other) noexcept
+    : m_code(std::exchange(other.m_code, nullptr)), m_size(other.m_size), m_resultType(other.m_resultType) { }
+
+JitFunction &JitFunction::operator=(JitFunction &&other) noexcept {
+    std::swap(m_code, other.m_code);
+    std::swap(m_size, other.m_size);
+    m_resultType = other.m_resultType;
+
+    return *this;
+}
+
+ResultOk<Token::Literal> JitFunction::operator()(const Bindings &bindings) const {
+    Slot result{};
+    if (function()(bindings.slots(), &result) != 0)
+        return Error("Division by zero");
+
+    switch (m_resultType) {
+        case ValueType::Signed:
+            return Token::Literal(result.s);
+        case ValueType::Unsigned:
+            return Token::Literal(result.u);
+        case ValueType::Float:
+        default:
+            return Token::Literal(result.f);
+    }
+}
+
+// lowering
+
+u32 Jit::newRegister(ValueType type) {
+    m_registerTypes.push_back(type);
+    return u32(m_registerTypes.size() - 1);
+}
+
+u32 Jit::newLabel() {
+    return m_labelCount++;
+}
+
+Jit::Value Jit::convert(Value value, ValueType type) {
+    if (value.type == type)
+        return value;
+
+    // signed and unsigned values share their bit pattern
+    if (type != ValueType::Float)
+        return { value.reg, type };
+
+    u32 dst = newRegister(ValueType::Float);
+    m_instructions.push_back({ .opcode = Opcode::IntToFloat, .type = value.type, .dst = dst, .a = value.reg });
+    return { dst, ValueType::Float };
+}
+
+Jit::Value Jit::toBool(Value value) {
+    u32 dst = newRegister(ValueType::Signed);
+    m_instructions.push_back({ .opcode = Opcode::ToBool, .type = value.type, .dst = dst, .a = value.reg });
+    return { dst, ValueType::Signed };
+}
+
+std::optional<Jit::Value> Jit::lowerBinary(Token::Operator op, const ast::AstNode *leftNode, const ast::AstNode *rightNode) {
+    // logical and / or short circuit
+    if (op == Token::Operator::BoolAnd || op == Token::Operator::BoolOr) {
+        u32 result = newRegister(ValueType::Signed);
+        u32 end = newLabel();
+
+        auto left = lower(leftNode);
+        if (!left.has_value())
+            return std::nullopt;
+
+        auto leftBool = toBool(*left);
+        m_instructions.push_back({ .opcode = Opcode::Move, .dst = result, .a = leftBool.reg });
+        m_instructions.push_back({ .opcode = op == Token::Operator::BoolAnd ? Opcode::JumpIfZero : Opcode::JumpIfNotZero,
+                                   .a = result, .immediate = end });
+
+        auto right = lower(rightNode);
+        if (!right.has_value())
+            return std::nullopt;
+
+        auto rightBool = toBool(*right);
+        m_instructions.push_back({ .opcode = Opcode::Move, .dst = result, .a = rightBool.reg });
+        m_instructions.push_back({ .opcode = Opcode::Label, .immediate = end });
+
+        return Value { result, ValueType::Signed };
+    }
+
+    auto left = lower(leftNode);
+    if (!left.has_value())
+        return std::nullopt;
+
+    auto right = lower(rightNode);
+    if (!right.has_value())
+        return std::nullopt;
+
+    if (op == Token::Operator::BoolXor) {
+        auto a = toBool(*left), b = toBool(*right);
+        u32 dst = newRegister(ValueType::Signed);
+        m_instructions.push_back({ .opcode = Opcode::Xor, .dst = dst, .a = a.reg, .b = b.reg });
+        return Value { dst, ValueType::Signed };
+    }
+
+    // shifts keep the type of the left operand
+    if (op == Token::Operator::LeftShift || op == Token::Operator::RightShift) {
+        if (left->type == ValueType::Float || right->type == ValueType::Float)
+            return std::nullopt;
+
+        u32 dst = newRegister(left->type);
+        m_instructions.push_back({ .opcode = op == Token::Operator::LeftShift ? Opcode::ShiftLeft : Opcode::ShiftRight,
+                                   .type = left->type, .dst = dst, .a = left->reg, .b = right->reg });
+        return Value { dst, left->type };
+    }
+
+    auto type = commonType(left->type, right->type);
+    auto a = convert(*left, type), b = convert(*right, type);
+
+    Opcode opcode;
+    switch (op) {
+        case Token::Operator::Equal:
+        case Token::Operator::NotEqual:
+        case Token::Operator::Less:
+        case Token::Operator::Greater:
+        case Token::Operator::LessEqual:
+        case Token::Operator::GreaterEqual: {
+            u32 dst = newRegister(ValueType::Signed);
+            m_instructions.push_back({ .opcode = Opcode::Compare, .type = type, .condition = op, .dst = dst, .a = a.reg, .b = b.reg });
+            return Value { dst, ValueType::Signed };
+        }
+        case Token::Operator::Plus:
+            opcode = Opcode::Add;
+            break;
+        case Token::Operator::Minus:
+            opcode = Opcode::Subtract;
+            break;
+        case Token::Operator::Multiply:
+            opcode = Opcode::Multiply;
+            break;
+        case Token::Operator::Divide:
+            opcode = Opcode::Divide;
+            break;
+        case Token::Operator::Modulo:
+            opcode = Opcode::Modulo;
+            break;
+        case Token::Operator::BitAnd:
+            opcode = Opcode::And;
+            break;
+        case Token::Operator::BitOr:
+            opcode = Opcode::Or;
+            break;
+        case Token::Operator::BitXor:
+            opcode = Opcode::Xor;
+            break;
+        default:
+            return std::nullopt;
+    }
+
+    bool integerOnly = opcode == Opcode::Modulo || opcode == Opcode::And || opcode == Opcode::Or || opcode == Opcode::Xor;
+    if (integerOnly && type == ValueType::Float)
+        return std::nullopt;
+
+    u32 dst = newRegister(type);
+    m_instructions.push_back({ .opcode = opcode, .type = type, .dst = dst, .a = a.reg, .b = b.reg });
+    return Value { dst, type };
+}
+
+std::optional<Jit::Value> Jit::lower(const ast::AstNode *node) {
+    if (auto literal = dynamic_cast<const ast::AstNodeLiteral *>(node)) {
+        auto type = Evaluator::typeOf(literal->literal());
+        if (!type.has_value())
+            return std::nullopt;
+
+        u64 bits = std::visit([](auto value) -> u64 {
+            if constexpr (std::is_same_v<decltype(value), Token::String>)
+                return 0;
+            else
+                return std::bit_cast<u64>(value);
+        }, literal->literal());
+
+        u32 dst = newRegister(*type);
+        m_instructions.push_back({ .opcode = Opcode::Constant, .type = *type, .dst = dst, .immediate = bits });
+        return Value { dst, *type };
+    }
+
+    if (auto identifier = dynamic_cast<const ast::AstNodeIdentifier *>(node)) {
+        auto index = m_layout->find(identifier->name());
+        if (!index.has_value())
+            return std::nullopt;
+
+        auto type = m_layout->type(*index);
+        u32 dst = newRegister(type);
+        m_instructions.push_back({ .opcode = Opcode::Load, .type = type, .dst = dst, .immediate = *index });
+        return Value { dst, type };
+    }
+
+    if (auto unary = dynamic_cast<const ast::AstNodeUnaryOperator *>(node)) {
+        auto operand = lower(unary->operand().get());
+        if (!operand.has_value())
+            return std::nullopt;
+
+        switch (unary->getOperator()) {
+            case Token::Operator::Plus:
+                return operand;
+            case Token::Operator::Minus:
+            case Token::Operator::BitNot: {
+                bool negate = unary->getOperator() == Token::Operator::Minus;
+                if (!negate && operand->type == ValueType::Float)
+                    return std::nullopt;
+
+                u32 dst = newRegister(operand->type);
+                m_instructions.push_back({ .opcode = negate ? Opcode::Negate : Opcode::Not, .type = operand->type, .dst = dst, .a = operand->reg });
+                return Value { dst, operand->type };
+            }
+            case Token::Operator::BoolNot: {
+                auto value = toBool(*operand);
+                u32 one = newRegister(ValueType::Signed);
+                m_instructions.push_back({ .opcode = Opcode::Constant, .dst = one, .immediate = 1 });
+
+                u32 dst = newRegister(ValueType::Signed);
+                m_instructions.push_back({ .opcode = Opcode::Xor, .dst = dst, .a = value.reg, .b = one });
+                return Value { dst, ValueType::Signed };
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+
+    if (auto binary = dynamic_cast<const ast::AstNodeBinaryOperator *>(node)) {
+        return lowerBinary(binary->getOperator(), binary->left().get(), binary->right().get());
+    }
+
+    if (auto ternary = dynamic_cast<const ast::AstNodeTernaryOperator *>(node)) {
+        auto condition = lower(ternary->condition().get());
+        if (!condition.has_value())
+            return std::nullopt;
+
+        u32 falseLabel = newLabel(), end = newLabel();
+        auto conditionBool = toBool(*condition);
+        m_instructions.push_back({ .opcode = Opcode::JumpIfZero, .a = conditionBool.reg, .immediate = falseLabel });
+
+        auto trueValue = lower(ternary->trueBranch().get());
+        if (!trueValue.has_value())
+            return std::nullopt;
+
+        // the interpreter does not convert the chosen branch, so both need the same static type
+        u32 result = newRegister(trueValue->type);
+        m_instructions.push_back({ .opcode = Opcode::Move, .type = trueValue->type, .dst = result, .a = trueValue->reg });
+        m_instructions.push_back({ .opcode = Opcode::Jump, .immediate = end });
+        m_instructions.push_back({ .opcode = Opcode::Label, .immediate = falseLabel });
+
+        auto falseValue = lower(ternary->falseBranch().get());
+        if (!falseValue.has_value() || falseValue->type != trueValue->type)
+            return std::nullopt;
+
+        m_instructions.push_back({ .opcode = Opcode::Move, .type = falseValue->type, .dst = result, .a = falseValue->reg });
+        m_instructions.push_back({ .opcode = Opcode::Label, .immediate = end });
+
+        return Value { result, trueValue->type };
+    }
+
+    return std::nullopt;
+}
+
+// register allocation
+
+void Jit::allocateRegisters() {
+    struct Interval {
+        u32 reg;
+        u32 start;
+        u32 end;
+    };
+
+    // code only ever jumps forwards, so a live range is simply first definition to last use in program order
+    std::vector<Interval> intervals(m_registerTypes.size(), { NoRegister, ~0u, 0 });
+    for (u32 position = 0; position < m_instructions.size(); ++position) {
+        const auto &instruction = m_instructions[position];
+        for (u32 reg : { instruction.dst, instruction.a, instruction.b }) {
+            if (reg == NoRegister)
+                continue;
+
+            intervals[reg].reg = reg;
+            intervals[reg].start = std::min(intervals[reg].start, position);
+            intervals[reg].end = std::max(intervals[reg].end, position);
+        }
+    }
+
+    std::erase_if(intervals, [](const Interval &interval) { return interval.reg == NoRegister; });
+    std::ranges::sort(intervals, {}, &Interval::start);
+
+    m_locations.assign(m_registerTypes.size(), { true, 0, 0 });
+    m_spillSlots = 0;
+
+    auto linearScan = [&](bool isFloat, std::vector<u8> freeRegisters) {
+        std::vector<Interval> active;
+
+        for (const auto &interval : intervals) {
+            if ((m_registerTypes[interval.reg] == ValueType::Float) != isFloat)
+                continue;
+
+            // expire intervals that ended before this one starts
+            std::erase_if(active, [&](const Interval &other) {
+                if (other.end >= interval.start)
+                    return false;
+
+                freeRegisters.push_back(m_locations[other.reg].reg);
+                return true;
+            });
+
+            if (!freeRegisters.empty()) {
+                m_locations[interval.reg] = { false, freeRegisters.back(), 0 };
+                freeRegisters.pop_back();
+                active.push_back(interval);
+                continue;
+            }
+
+            // spill whichever interval lives the longest
+            auto longest = std::ranges::max_element(active, {}, &Interval::end);
+            if (longest != active.end() && longest->end > interval.end) {
+                m_locations[interval.reg] = { false, m_locations[longest->reg].reg, 0 };
+                m_locations[longest->reg] = { true, 0, m_spillSlots++ };
+                *longest = interval;
+            } else {
+                m_locations[interval.reg] = { true, 0, m_spillSlots++ };
+            }
+        }
+    };
+
+    linearScan(false, { r15, r14, r13, r12, r10, r9, r8, rbx });
+    linearScan(true, { xmm15, xmm14, xmm13, xmm12, xmm11, xmm10, xmm9, xmm8, xmm7, xmm6, xmm5, xmm4, xmm3, xmm2 });
+}
+
+// code generation
+
+static Condition integerCondition(Token::Operator op, bool isSigned) {
+    switch (op) {
+        case Token::Operator::Equal:
+            return Condition::Equal;
+        case Token::Operator::NotEqual:
+            return Condition::NotEqual;
+        case Token::Operator::Less:
+            return isSigned ? Condition::Less : Condition::Below;
+        case Token::Operator::Greater:
+            return isSigned ? Condition::Greater : Condition::Above;
+        case Token::Operator::LessEqual:
+            return isSigned ? Condition::LessEqual : Condition::BelowEqual;
+        case Token::Operator::GreaterEqual:
+        default:
+            return isSigned ? Condition::GreaterEqual : Condition::AboveEqual;
+    }
+}
+
+std::vector<u8> Jit::generate() {
+    Assembler assembler;
+
+    auto operand = [this](u32 reg) {
+        const auto &location = m_locations[reg];
+        if (location.spilled)
+            return Operand::memoryOperand(rsp, s32(location.slot * 8));
+        else
+            return Operand::registerOperand(location.reg);
+    };
+    auto slot = [](u64 index) {
+        return Operand::memoryOperand(rdi, s32(index * 8));
+    };
+
+    std::vector<u32> labels(m_labelCount);
+    for (auto &label : labels)
+        label = assembler.createLabel();
+
+    u32 error = assembler.createLabel();
+    u32 epilogue = assembler.createLabel();
+
+    const Register calleeSaved[] = { rbx, r12, r13, r14, r15 };
+    s32 frameSize = s32((m_spillSlots * 8 + 15) & ~15u);
+
+    for (auto reg : calleeSaved)
+        assembler.push(reg);
+    if (frameSize != 0)
+        assembler.subRsp(frameSize);
+
+    // every instruction works on rax / rcx / rdx and xmm0 / xmm1, operands are read straight from their allocated location
+    for (const auto &instruction : m_instructions) {
+        bool isFloat = instruction.type == ValueType::Float;
+
+        switch (instruction.opcode) {
+            case Opcode::Constant:
+                assembler.movImmediate(rax, instruction.immediate);
+                if (isFloat) {
+                    assembler.movq(xmm0, rax);
+                    assembler.movsd(operand(instruction.dst), xmm0);
+                } else {
+                    assembler.mov(operand(instruction.dst), rax);
+                }
+                break;
+            case Opcode::Load:
+            case Opcode::Move: {
+                auto source = instruction.opcode == Opcode::Load ? slot(instruction.immediate) : operand(instruction.a);
+                if (isFloat) {
+                    assembler.movsd(xmm0, source);
+                    assembler.movsd(operand(instruction.dst), xmm0);
+                } else {
+                    assembler.mov(rax, source);
+                    assembler.mov(operand(instruction.dst), rax);
+                }
+                break;
+            }
+            case Opcode::Add:
+            case Opcode::Subtract:
+            case Opcode::Multiply:
+            case Opcode::And:
+            case Opcode::Or:
+            case Opcode::Xor:
+                if (isFloat) {
+                    auto op = instruction.opcode == Opcode::Add ? SseOp::AddSd
+                            : instruction.opcode == Opcode::Subtract ? SseOp::SubSd : SseOp::MulSd;
+                    assembler.movsd(xmm0, operand(instruction.a));
+                    assembler.sse(op, xmm0, operand(instruction.b));
+                    assembler.movsd(operand(instruction.dst), xmm0);
+                } else {
+                    assembler.mov(rax, operand(instruction.a));
+                    switch (instruction.opcode) {
+                        case Opcode::Add: assembler.alu(AluOp::Add, rax, operand(instruction.b)); break;
+                        case Opcode::Subtract: assembler.alu(AluOp::Sub, rax, operand(instruction.b)); break;
+                        case Opcode::Multiply: assembler.imul(rax, operand(instruction.b)); break;
+                        case Opcode::And: assembler.alu(AluOp::And, rax, operand(instruction.b)); break;
+                        case Opcode::Or: assembler.alu(AluOp::Or, rax, operand(instruction.b)); break;
+                        default: assembler.alu(AluOp::Xor, rax, operand(instruction.b)); break;
+                    }
+                    assembler.mov(operand(instruction.dst), rax);
+                }
+                break;
+            case Opcode::Divide:
+            case Opcode::Modulo: {
+                if (isFloat) {
+                    assembler.movsd(xmm0, operand(instruction.a));
+                    assembler.sse(SseOp::DivSd, xmm0, operand(instruction.b));
+                    assembler.movsd(operand(instruction.dst), xmm0);
+                    break;
+                }
+
+                bool divide = instruction.opcode == Opcode::Divide;
+                assembler.mov(rax, operand(instruction.a));
+                assembler.mov(rcx, operand(instruction.b));
+                assembler.test(rcx, rcx);
+                assembler.jcc(Condition::Equal, error);
+
+                if (instruction.type == ValueType::Signed) {
+                    // s64 minimum / -1 would trap, it wraps around like in the interpreter
+                    u32 regular = assembler.createLabel(), done = assembler.createLabel();
+                    assembler.cmpImmediate(rcx, -1);
+                    assembler.jcc(Condition::NotEqual, regular);
+                    if (divide)
+                        assembler.unary(UnaryOp::Neg, Operand::registerOperand(rax));
+                    else
+                        assembler.alu(AluOp::Xor, rax, Operand::registerOperand(rax));
+                    assembler.jmp(done);
+
+                    assembler.bind(regular);
+                    assembler.cqo();
+                    assembler.unary(UnaryOp::IDiv, Operand::registerOperand(rcx));
+                    if (!divide)
+                        assembler.mov(rax, Operand::registerOperand(rdx));
+                    assembler.bind(done);
+                } else {
+                    assembler.alu(AluOp::Xor, rdx, Operand::registerOperand(rdx));
+                    assembler.unary(UnaryOp::Div, Operand::registerOperand(rcx));
+                    if (!divide)
+                        assembler.mov(rax, Operand::registerOperand(rdx));
+                }
+
+                assembler.mov(operand(instruction.dst), rax);
+                break;
+            }
+            case Opcode::ShiftLeft:
+            case Opcode::ShiftRight: {
+                auto op = instruction.opcode == Opcode::ShiftLeft ? ShiftOp::Shl
+                        : instruction.type == ValueType::Signed ? ShiftOp::Sar : ShiftOp::Shr;
+
+                // the count is taken modulo 64 by the hardware
+                assembler.mov(rax, operand(instruction.a));
+                assembler.mov(rcx, operand(instruction.b));
+                assembler.shift(op, rax);
+                assembler.mov(operand(instruction.dst), rax);
+                break;
+            }
+            case Opcode::Negate:
+                if (isFloat) {
+                    assembler.movsd(xmm0, operand(instruction.a));
+                    assembler.movq(rax, xmm0);
+                    assembler.btcImmediate(rax, 63);
+                    assembler.movq(xmm0, rax);
+                    assembler.movsd(operand(instruction.dst), xmm0);
+                } else {
+                    assembler.mov(rax, operand(instruction.a));
+                    assembler.unary(UnaryOp::Neg, Operand::registerOperand(rax));
+                    assembler.mov(operand(instruction.dst), rax);
+                }
+                break;
+            case Opcode::Not:
+                assembler.mov(rax, operand(instruction.a));
+                assembler.unary(UnaryOp::Not, Operand::registerOperand(rax));
+                assembler.mov(operand(instruction.dst), rax);
+                break;
+            case Opcode::Compare:
+                if (isFloat) {
+                    // ucomisd reports unordered as ZF = PF = CF = 1, so NaN compares false except for !=
+                    switch (instruction.condition) {
+                        case Token::Operator::Less:
+                        case Token::Operator::LessEqual:
+                            assembler.movsd(xmm0, operand(instruction.b));
+                            assembler.ucomisd(xmm0, operand(instruction.a));
+                            assembler.setcc(instruction.condition == Token::Operator::Less ? Condition::Above : Condition::AboveEqual, rax);
+                            break;
+                        case Token::Operator::Greater:
+                        case Token::Operator::GreaterEqual:
+                            assembler.movsd(xmm0, operand(instruction.a));
+                            assembler.ucomisd(xmm0, operand(instruction.b));
+                            assembler.setcc(instruction.condition == Token::Operator::Greater ? Condition::Above : Condition::AboveEqual, rax);
+                            break;
+                        case Token::Operator::Equal:
+                            assembler.movsd(xmm0, operand(instruction.a));
+                            assembler.ucomisd(xmm0, operand(instruction.b));
+                            assembler.setcc(Condition::Equal, rax);
+                            assembler.setcc(Condition::NoParity, rcx);
+                            assembler.andByte(rax, rcx);
+                            break;
+                        default:
+                            assembler.movsd(xmm0, operand(instruction.a));
+                            assembler.ucomisd(xmm0, operand(instruction.b));
+                            assembler.setcc(Condition::NotEqual, rax);
+                            assembler.setcc(Condition::Parity, rcx);
+                            assembler.orByte(rax, rcx);
+                            break;
+                    }
+                } else {
+                    assembler.mov(rax, operand(instruction.a));
+                    assembler.alu(AluOp::Cmp, rax, operand(instruction.b));
+                    assembler.setcc(integerCondition(instruction.condition, instruction.type == ValueType::Signed), rax);
+                }
+                assembler.movzxByte(rax, rax);
+                assembler.mov(operand(instruction.dst), rax);
+                break;
+            case Opcode::ToBool:
+                if (isFloat) {
+                    assembler.movsd(xmm0, operand(instruction.a));
+                    assembler.xorpd(xmm1, xmm1);
+                    assembler.ucomisd(xmm0, Operand::registerOperand(xmm1));
+                    assembler.setcc(Condition::NotEqual, rax);
+                    assembler.setcc(Condition::Parity, rcx);
+                    assembler.orByte(rax, rcx);
+                } else {
+                    assembler.mov(rax, operand(instruction.a));
+                    assembler.test(rax, rax);
+                    assembler.setcc(Condition::NotEqual, rax);
+                }
+                assembler.movzxByte(rax, rax);
+                assembler.mov(operand(instruction.dst), rax);
+                break;
+            case Opcode::IntToFloat:
+                assembler.mov(rax, operand(instruction.a));
+                if (instruction.type == ValueType::Signed) {
+                    assembler.cvtsi2sd(xmm0, rax);
+                } else {
+                    // values with the top bit set are halved, keeping the lowest bit for correct rounding, and doubled afterwards
+                    u32 large = assembler.createLabel(), done = assembler.createLabel();
+                    assembler.test(rax, rax);
+                    assembler.jcc(Condition::Sign, large);
+                    assembler.cvtsi2sd(xmm0, rax);
+                    assembler.jmp(done);
+
+                    assembler.bind(large);
+                    assembler.mov(rcx, Operand::registerOperand(rax));
+                    assembler.shiftImmediate(ShiftOp::Shr, rcx, 1);
+                    assembler.movImmediate(rdx, 1);
+                    assembler.alu(AluOp::And, rdx, Operand::registerOperand(rax));
+                    assembler.alu(AluOp::Or, rcx, Operand::registerOperand(rdx));
+                    assembler.cvtsi2sd(xmm0, rcx);
+                    assembler.sse(SseOp::AddSd, xmm0, Operand::registerOperand(xmm0));
+                    assembler.bind(done);
+                }
+                assembler.movsd(operand(instruction.dst), xmm0);
+                break;
+            case Opcode::Jump:
+                assembler.jmp(labels[instruction.immediate]);
+                break;
+            case Opcode::JumpIfZero:
+            case Opcode::JumpIfNotZero:
+                assembler.mov(rax, operand(instruction.a));
+                assembler.test(rax, rax);
+                assembler.jcc(instruction.opcode == Opcode::JumpIfZero ? Condition::Equal : Condition::NotEqual, labels[instruction.immediate]);
+                break;
+            case Opcode::Label:
+                assembler.bind(labels[instruction.immediate]);
+                break;
+            case Opcode::Return:
+                if (isFloat) {
+                    assembler.movsd(xmm0, operand(instruction.a));
+                    assembler.movsd(Operand::memoryOperand(rsi, 0), xmm0);
+                } else {
+                    assembler.mov(rax, operand(instruction.a));
+                    assembler.mov(Operand::memoryOperand(rsi, 0), rax);
+                }
+                assembler.alu(AluOp::Xor, rax, Operand::registerOperand(rax));
+                assembler.jmp(epilogue);
+                break;
+        }
+    }
+
+    assembler.bind(error);
+    assembler.movImmediate(rax, 1);
+
+    assembler.bind(epilogue);
+    if (frameSize != 0)
+        assembler.addRsp(frameSize);
+    for (auto it = std::rbegin(calleeSaved); it != std::rend(calleeSaved); ++it)
+        assembler.pop(*it);
+    assembler.ret();
+
+    return assembler.finish();
+}
+
+std::optional<JitFunction> Jit::compile(const std::shared_ptr<ast::AstNode> &expression, const Bindings &layout) {
+#if defined(BOOTSTRAP_JIT_SUPPORTED)
+    m_instructions.clear();
+    m_registerTypes.clear();
+    m_labelCount = 0;
+    m_layout = &layout;
+
+    auto result = lower(expression.get());
+    if (!result.has_value())
+        return std::nullopt;
+
+    m_instructions.push_back({ .opcode = Opcode::Return, .type = result->type, .a = result->reg });
+
+    allocateRegisters();
+    auto code = generate();
+
+    // write the code first and only then make it executable, never both at once
+    void *memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return std::nullopt;
+
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, code.size());
+        return std::nullopt;
+    }
+
+    return JitFunction(memory, code.size(), result->type);
+#else
+    (void) expression;
+    (void) layout;
+    return std::nullopt;
+#endif
+}
+
+// CompiledExpression
+
+CompiledExpression::CompiledExpression(std::shared_ptr<ast::AstNode> expression, const Bindings &layout)
+    : m_expression(std::move(expression)), m_layout(layout.layout()), m_native(Jit().compile(m_expression, layout)) { }
+
+ResultOk<Token::Literal> CompiledExpression::evaluate(const Bindings &bindings) const {
+    // native code addresses slots by their compile time index and type
+    if (m_native.has_value() && bindings.hasLayout(m_layout))
+        return (*m_native)(bindings);
+
+    return Evaluator().evaluate(m_expression, bindings);
+}
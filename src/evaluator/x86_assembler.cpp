@@ -0,0 +1,216 @@
+#include "evaluator/x86_assembler.h"
+
+using namespace evaluator::x86;
+
+void Assembler::emit(u8 byte) {
+    m_code.push_back(byte);
+}
+
+void Assembler::emit32(u32 value) {
+    for (int i = 0; i < 4; ++i)
+        emit(u8(value >> (i * 8)));
+}
+
+void Assembler::emitInstruction(u8 prefix, bool wide, std::initializer_list<u8> opcode, u8 reg, Operand rm) {
+    // legacy prefixes have to come before REX
+    if (prefix != 0)
+        emit(prefix);
+
+    u8 rex = 0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((rm.reg & 8) ? 0x01 : 0);
+    if (rex != 0x40)
+        emit(rex);
+
+    for (u8 byte : opcode)
+        emit(byte);
+
+    if (!rm.memory) {
+        emit(0xC0 | ((reg & 7) << 3) | (rm.reg & 7));
+        return;
+    }
+
+    bool shortDisplacement = rm.displacement >= -128 && rm.displacement <= 127;
+    emit((shortDisplacement ? 0x40 : 0x80) | ((reg & 7) << 3) | (rm.reg & 7));
+
+    // rsp and r12 as base need a SIB byte
+    if ((rm.reg & 7) == rsp)
+        emit(0x24);
+
+    if (shortDisplacement)
+        emit(u8(rm.displacement));
+    else
+        emit32(u32(rm.displacement));
+}
+
+u32 Assembler::createLabel() {
+    m_labels.push_back(-1);
+    return u32(m_labels.size() - 1);
+}
+
+void Assembler::bind(u32 label) {
+    m_labels[label] = s64(m_code.size());
+}
+
+void Assembler::mov(Register dst, Operand src) {
+    emitInstruction(0, true, { 0x8B }, dst, src);
+}
+
+void Assembler::mov(Operand dst, Register src) {
+    emitInstruction(0, true, { 0x89 }, src, dst);
+}
+
+void Assembler::movImmediate(Register dst, u64 immediate) {
+    // a 32 bit move zero extends, which saves four bytes for small constants
+    bool wide = immediate > 0xFFFFFFFF;
+    u8 rex = 0x40 | (wide ? 0x08 : 0) | ((dst & 8) ? 0x01 : 0);
+    if (rex != 0x40)
+        emit(rex);
+
+    emit(0xB8 + (dst & 7));
+    emit32(u32(immediate));
+    if (wide)
+        emit32(u32(immediate >> 32));
+}
+
+void Assembler::alu(AluOp op, Register dst, Operand src) {
+    emitInstruction(0, true, { u8(op) }, dst, src);
+}
+
+void Assembler::imul(Register dst, Operand src) {
+    emitInstruction(0, true, { 0x0F, 0xAF }, dst, src);
+}
+
+void Assembler::unary(UnaryOp op, Operand operand) {
+    emitInstruction(0, true, { 0xF7 }, u8(op), operand);
+}
+
+void Assembler::shift(ShiftOp op, Register dst) {
+    emitInstruction(0, true, { 0xD3 }, u8(op), Operand::registerOperand(dst));
+}
+
+void Assembler::shiftImmediate(ShiftOp op, Register dst, u8 count) {
+    emitInstruction(0, true, { 0xC1 }, u8(op), Operand::registerOperand(dst));
+    emit(count);
+}
+
+void Assembler::cmpImmediate(Register dst, s8 immediate) {
+    emitInstruction(0, true, { 0x83 }, 7, Operand::registerOperand(dst));
+    emit(u8(immediate));
+}
+
+void Assembler::test(Register left, Register right) {
+    emitInstruction(0, true, { 0x85 }, right, Operand::registerOperand(left));
+}
+
+void Assembler::btcImmediate(Register dst, u8 bit) {
+    emitInstruction(0, true, { 0x0F, 0xBA }, 7, Operand::registerOperand(dst));
+    emit(bit);
+}
+
+void Assembler::cqo() {
+    emit(0x48);
+    emit(0x99);
+}
+
+void Assembler::setcc(Condition condition, Register dst) {
+    emitInstruction(0, false, { 0x0F, u8(0x90 + u8(condition)) }, 0, Operand::registerOperand(dst));
+}
+
+void Assembler::andByte(Register dst, Register src) {
+    emitInstruction(0, false, { 0x20 }, src, Operand::registerOperand(dst));
+}
+
+void Assembler::orByte(Register dst, Register src) {
+    emitInstruction(0, false, { 0x08 }, src, Operand::registerOperand(dst));
+}
+
+void Assembler::movzxByte(Register dst, Register src) {
+    emitInstruction(0, false, { 0x0F, 0xB6 }, dst, Operand::registerOperand(src));
+}
+
+void Assembler::addRsp(s32 immediate) {
+    emitInstruction(0, true, { 0x81 }, 0, Operand::registerOperand(rsp));
+    emit32(u32(immediate));
+}
+
+void Assembler::subRsp(s32 immediate) {
+    emitInstruction(0, true, { 0x81 }, 5, Operand::registerOperand(rsp));
+    emit32(u32(immediate));
+}
+
+void Assembler::push(Register reg) {
+    if (reg & 8)
+        emit(0x41);
+    emit(0x50 + (reg & 7));
+}
+
+void Assembler::pop(Register reg) {
+    if (reg & 8)
+        emit(0x41);
+    emit(0x58 + (reg & 7));
+}
+
+void Assembler::ret() {
+    emit(0xC3);
+}
+
+void Assembler::jmp(u32 label) {
+    emit(0xE9);
+    m_fixups.push_back({ u32(m_code.size()), label });
+    emit32(0);
+}
+
+void Assembler::jcc(Condition condition, u32 label) {
+    emit(0x0F);
+    emit(0x80 + u8(condition));
+    m_fixups.push_back({ u32(m_code.size()), label });
+    emit32(0);
+}
+
+void Assembler::movsd(Xmm dst, Operand src) {
+    if (src.memory)
+        emitInstruction(0xF2, false, { 0x0F, 0x10 }, dst, src);
+    else
+        emitInstruction(0x66, false, { 0x0F, 0x28 }, dst, src); // movapd
+}
+
+void Assembler::movsd(Operand dst, Xmm src) {
+    if (dst.memory)
+        emitInstruction(0xF2, false, { 0x0F, 0x11 }, src, dst);
+    else
+        emitInstruction(0x66, false, { 0x0F, 0x28 }, dst.reg, Operand::registerOperand(src)); // movapd
+}
+
+void Assembler::sse(SseOp op, Xmm dst, Operand src) {
+    emitInstruction(0xF2, false, { 0x0F, u8(op) }, dst, src);
+}
+
+void Assembler::ucomisd(Xmm left, Operand right) {
+    emitInstruction(0x66, false, { 0x0F, 0x2E }, left, right);
+}
+
+void Assembler::xorpd(Xmm dst, Xmm src) {
+    emitInstruction(0x66, false, { 0x0F, 0x57 }, dst, Operand::registerOperand(src));
+}
+
+void Assembler::movq(Xmm dst, Register src) {
+    emitInstruction(0x66, true, { 0x0F, 0x6E }, dst, Operand::registerOperand(src));
+}
+
+void Assembler::movq(Register dst, Xmm src) {
+    emitInstruction(0x66, true, { 0x0F, 0x7E }, src, Operand::registerOperand(dst));
+}
+
+void Assembler::cvtsi2sd(Xmm dst, Register src) {
+    emitInstruction(0xF2, true, { 0x0F, 0x2A }, dst, Operand::registerOperand(src));
+}
+
+std::vector<u8> Assembler::finish() {
+    for (const auto &fixup : m_fixups) {
+        s64 relative = m_labels[fixup.label] - s64(fixup.position + 4);
+        for (int i = 0; i < 4; ++i)
+            m_code[fixup.position + i] = u8(u64(relative) >> (i * 8));
+    }
+
+    m_fixups.clear();
+    return std::move(m_code);
+}
@@ -1,5 +1,6 @@
 #include "parser/lexer.h"
 #include "common/string_util.hpp"
+#include "common/character_util.hpp"
 
 #include <optional>
 
@@ -9,67 +10,54 @@ using namespace util;
 std::optional<char> Lexer::parseCharacter() {
     const char& c = m_sourceCode[m_cursor];
     if (c == '\\') {
-        m_cursor++;
-        switch (m_sourceCode[m_cursor++]) {
-            case 'a':
-                return '\a';
-            case 'b':
-                return '\b';
-            case 'f':
-                return '\f';
-            case 'n':
-                return '\n';
-            case 't':
-                return '\t';
-            case 'r':
-                return '\r';
-            case '0':
-                return '\0';
-            case '\'':
-                return '\'';
-            case '\\':
-                return '\\';
-            case 'x': {
-                char hex[3] = { m_sourceCode[m_cursor], m_sourceCode[m_cursor + 1], 0 };
-                m_cursor += 2;
-                return static_cast<char>(std::stoul(hex, nullptr, 16));
-            }
-            case 'u': {
-                char hex[5] = { m_sourceCode[m_cursor], m_sourceCode[m_cursor + 1], m_sourceCode[m_cursor + 2],
-                                m_sourceCode[m_cursor + 3], 0 };
-                m_cursor += 4;
-                return static_cast<char>(std::stoul(hex, nullptr, 16));
-            }
-            default:
-                this->error("Unknown escape sequence: {}", m_sourceCode[m_cursor]);
-                return std::nullopt;
+        size_t cursor = m_cursor;
+        auto character = util::parse_escape_sequence(m_sourceCode, cursor);
+        m_cursor = cursor;
+
+        if (!character.has_value()) {
+            this->error("Unknown escape sequence: {}", m_sourceCode[m_cursor]);
+            return std::nullopt;
         }
+
+        return character;
     } else {
+        m_cursor++;
         return c;
     }
 }
 
 std::optional<Token> Lexer::parseStringLiteral() {
-    std::string result;
-
     m_cursor++;
-    while(m_sourceCode[m_cursor] != '\"') {
-
-        auto character = parseCharacter();
-
-        if(character.has_value()) {
-            result += character.value();
-        } else {
-            return std::nullopt;
-        }
-
-        if(m_cursor > m_sourceCode.size()) {
+    u32 begin = m_cursor;
+    bool hasEscapes = false;
+    bool valid = true;
+
+    // only validate escape sequences here, decoding happens on demand in Token::String::decode
+    while (true) {
+        size_t next = m_sourceCode.find_first_of("\"\\", m_cursor);
+        if (next == std::string::npos) {
+            m_cursor = m_sourceCode.size();
             this->error("Unexpected end of string literal");
             return std::nullopt;
         }
 
+        m_cursor = next;
+        if (m_sourceCode[m_cursor] == '\"')
+            break;
+
+        // keep scanning after an invalid escape, so lexing resumes behind the closing quote
+        hasEscapes = true;
+        if (!parseCharacter().has_value())
+            valid = false;
     }
-    return makeToken(tokens::Literal::makeString(result));
+
+    std::string_view raw(m_sourceCode.data() + begin, m_cursor - begin);
+    m_cursor++;
+
+    if (!valid)
+        return std::nullopt;
+
+    return makeToken(tokens::Literal::makeString(Token::String(raw, hasEscapes)));
 }
 
 std::optional<Token::Literal> Lexer::parseIntegerLiteral(std::string_view literal) {
@@ -151,8 +139,9 @@ std::optional<Token::Literal> Lexer::parseIntegerLiteral(std::string_view litera
 }
 
 std::optional<Token> Lexer::parseOperator() {
-    auto operators = Token::operators();
-    for (int i = 1; i <= tokens::Operator::maxOperatorLength; ++i) {
+    auto &operators = Token::operators();
+    // longest match first, so `<<` is not lexed as two `<`
+    for (int i = tokens::Operator::maxOperatorLength; i >= 1; --i) {
         auto operatorToken = operators.find(m_sourceCode.substr(m_cursor, i));
         if (operatorToken != operators.end()) {
             m_cursor += i;
@@ -163,7 +152,7 @@ std::optional<Token> Lexer::parseOperator() {
 }
 
 std::optional<Token> Lexer::parseSeparator() {
-    auto separators = Token::separators();
+    auto &separators = Token::separators();
     auto separatorToken = separators.find(m_sourceCode[m_cursor]);
     if (separatorToken != separators.end()) {
         m_cursor++;
@@ -173,7 +162,7 @@ std::optional<Token> Lexer::parseSeparator() {
 }
 
 std::optional<Token> Lexer::parseKeyword(const std::string &identifier) {
-    auto keywords = Token::keywords();
+    auto &keywords = Token::keywords();
     auto keywordToken = keywords.find(identifier);
     if (keywordToken != keywords.end()) {
         return makeToken(keywordToken->second);
@@ -189,6 +178,7 @@ util::Results<std::vector<Token>> Lexer::lex(const std::string &sourceCode) {
     this->m_sourceCode = sourceCode;
     this->m_cursor = 0;
     this->m_line = 1;
+    this->m_errors.clear();
 
     size_t end = this->m_sourceCode.size();
 
@@ -205,6 +195,9 @@ util::Results<std::vector<Token>> Lexer::lex(const std::string &sourceCode) {
                 m_line++;
                 m_lineBegin = m_cursor;
             }
+
+            m_cursor++;
+            continue;
         }
 
         auto operatorToken = parseOperator();
@@ -221,12 +214,12 @@ util::Results<std::vector<Token>> Lexer::lex(const std::string &sourceCode) {
 
         // literals
         if (c == '"') {
+            // errors are reported by parseStringLiteral, which always consumes the whole literal
             auto string = parseStringLiteral();
-
-            if (string.has_value()) {
+            if (string.has_value())
                 tokens.emplace_back(string.value());
-                continue;
-            }
+
+            continue;
         } else if(c == '\'') {
             m_cursor++;
             auto character = parseCharacter();
@@ -236,6 +229,7 @@ util::Results<std::vector<Token>> Lexer::lex(const std::string &sourceCode) {
                     this->error("Expected closing '");
                     continue;
                 }
+                m_cursor++;
 
                 tokens.emplace_back(tokens::Literal::makeNumeric(character.value()));
                 continue;
@@ -277,5 +271,12 @@ util::Results<std::vector<Token>> Lexer::lex(const std::string &sourceCode) {
         m_cursor++;
     }
 
+    if (!m_errors.empty()) {
+        for (const auto &error : m_errors)
+            errors.emplace_back(fmt::format("{}:{}: {}", error.location().line, error.location().column, error.get_message()));
+
+        return errors;
+    }
+
     return tokens;
 }
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "parser/parser.h"
+#include "parser/ast/ast_node_literal.hpp"
+#include "parser/ast/ast_node_identifier.hpp"
+#include "parser/ast/ast_node_unary_operator.hpp"
+#include "parser/ast/ast_node_binary_operator.hpp"
+#include "parser/ast/ast_node_member_access.hpp"
+#include "parser/ast/ast_node_function_call.hpp"
+#include "parser/ast/ast_node_cast.hpp"
+#include "parser/ast/ast_node_ternary_operator.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace parser;
+using namespace util;
+
+std::vector<Parser::StatementRange> Parser::findStatementBoundaries(const std::vector<Token> &tokens) {
+    std::vector<StatementRange> statements;
+
+    auto begin = tokens.begin();
+    for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+        if (it->type() != Token::Type::Separator || std::get<Token::Separator>(it->value()) != Token::Separator::Semicolon)
+            continue;
+
+        statements.push_back({ begin, it + 1 });
+        begin = it + 1;
+    }
+
+    // trailing statement without a semicolon, reported as an error when parsed
+    if (begin != tokens.end())
+        statements.push_back({ begin, tokens.end() });
+
+    return statements;
+}
+
+Location Parser::currentLocation() const {
+    if (!atEnd())
+        return m_current->location();
+    else if (m_current != m_begin)
+        return std::prev(m_current)->location();
+    else
+        return { 0, 0 };
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseFunctionCall(const std::string &name) {
+    std::vector<std::shared_ptr<ast::AstNode>> arguments;
+
+    m_current++; // (
+    if (!consume(tokens::Separator::RightParenthesis)) {
+        while (true) {
+            auto argument = parseExpression();
+            if (argument == nullptr)
+                return nullptr;
+
+            arguments.push_back(std::move(argument));
+
+            if (consume(tokens::Separator::RightParenthesis))
+                break;
+            if (!consume(tokens::Separator::Comma))
+                return error("Expected ',' or ')' in argument list");
+        }
+    }
+
+    return create<ast::AstNodeFunctionCall>(name, std::move(arguments));
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseMemberAccess(std::shared_ptr<ast::AstNode> object) {
+    if (object == nullptr)
+        return nullptr;
+
+    while (consume(tokens::Separator::Dot)) {
+        if (!peek(Token::Type::Identifier))
+            return error("Expected identifier after '.'");
+
+        auto &member = std::get<Token::Identifier>(m_current->value()).get();
+        object = create<ast::AstNodeMemberAccess>(std::move(object), member);
+        m_current++;
+    }
+
+    return object;
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseFactor() {
+    if (atEnd())
+        return error("Unexpected end of statement");
+
+    if (consume(tokens::Separator::LeftParenthesis)) {
+        auto expression = parseExpression();
+        if (expression == nullptr)
+            return nullptr;
+
+        if (!consume(tokens::Separator::RightParenthesis))
+            return error("Expected ')'");
+
+        return parseMemberAccess(std::move(expression));
+    }
+
+    if (peek(Token::Type::Integer) || peek(Token::Type::String)) {
+        auto literal = create<ast::AstNodeLiteral>(std::get<Token::Literal>(m_current->value()));
+        m_current++;
+        return literal;
+    }
+
+    if (peek(Token::Type::Identifier)) {
+        auto &name = std::get<Token::Identifier>(m_current->value()).get();
+        m_current++;
+
+        if (peek(tokens::Separator::LeftParenthesis)) {
+            auto call = parseFunctionCall(name);
+            if (call == nullptr)
+                return nullptr;
+
+            return parseMemberAccess(std::move(call));
+        }
+
+        return parseMemberAccess(create<ast::AstNodeIdentifier>(name));
+    }
+
+    return error("Unexpected token in expression");
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseUnaryExpression() {
+    auto op = peekOperator({ Token::Operator::Plus, Token::Operator::Minus, Token::Operator::BitNot, Token::Operator::BoolNot });
+    if (op.has_value()) {
+        m_current++;
+
+        if (m_depth >= maxNestingDepth)
+            return error("Expression nested too deeply");
+
+        m_depth++;
+        auto operand = parseUnaryExpression();
+        m_depth--;
+        if (operand == nullptr)
+            return nullptr;
+
+        return create<ast::AstNodeUnaryOperator>(*op, std::move(operand));
+    }
+
+    return parseCastExpression();
+}
+
+bool Parser::isCast() const {
+    // a cast is exactly `( type_name )`, so three tokens of lookahead decide it without backtracking
+    if (std::distance(m_current, m_end) < 3 || !peek(tokens::Separator::LeftParenthesis))
+        return false;
+
+    const auto &name = *(m_current + 1);
+    const auto &close = *(m_current + 2);
+    return name.type() == Token::Type::Identifier
+        && close.type() == Token::Type::Separator
+        && std::get<Token::Separator>(close.value()) == Token::Separator::RightParenthesis
+        && m_typeNames.contains(std::get<Token::Identifier>(name.value()).get());
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseCastExpression() {
+    std::vector<std::string> types;
+    while (isCast()) {
+        types.push_back(std::get<Token::Identifier>((m_current + 1)->value()).get());
+        m_current += 3;
+    }
+
+    auto expression = parseFactor();
+
+    // the innermost cast is applied first
+    for (auto it = types.rbegin(); expression != nullptr && it != types.rend(); ++it) {
+        expression = create<ast::AstNodeCast>(std::move(*it), std::move(expression));
+    }
+
+    return expression;
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseBinaryExpression(std::shared_ptr<ast::AstNode> (Parser::*parseOperand)(),
+                                                            std::initializer_list<Token::Operator> operators) {
+    auto left = (this->*parseOperand)();
+
+    std::optional<Token::Operator> op;
+    while (left != nullptr && (op = peekOperator(operators)).has_value()) {
+        m_current++;
+
+        auto right = (this->*parseOperand)();
+        if (right == nullptr)
+            return nullptr;
+
+        left = create<ast::AstNodeBinaryOperator>(*op, std::move(left), std::move(right));
+    }
+
+    return left;
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseMultiplicativeExpression() {
+    return parseBinaryExpression(&Parser::parseUnaryExpression,
+                                 { Token::Operator::Multiply, Token::Operator::Divide, Token::Operator::Modulo });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseAdditiveExpression() {
+    return parseBinaryExpression(&Parser::parseMultiplicativeExpression, { Token::Operator::Plus, Token::Operator::Minus });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseShiftExpression() {
+    return parseBinaryExpression(&Parser::parseAdditiveExpression, { Token::Operator::LeftShift, Token::Operator::RightShift });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseBinaryAndExpression() {
+    return parseBinaryExpression(&Parser::parseShiftExpression, { Token::Operator::BitAnd });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseBinaryXorExpression() {
+    return parseBinaryExpression(&Parser::parseBinaryAndExpression, { Token::Operator::BitXor });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseBinaryOrExpression() {
+    return parseBinaryExpression(&Parser::parseBinaryXorExpression, { Token::Operator::BitOr });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseRelationalExpression() {
+    return parseBinaryExpression(&Parser::parseBinaryOrExpression,
+                                 { Token::Operator::Less, Token::Operator::Greater, Token::Operator::LessEqual, Token::Operator::GreaterEqual });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseEqualityExpression() {
+    return parseBinaryExpression(&Parser::parseRelationalExpression, { Token::Operator::Equal, Token::Operator::NotEqual });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseAndExpression() {
+    return parseBinaryExpression(&Parser::parseEqualityExpression, { Token::Operator::BoolAnd });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseBoolXorExpression() {
+    return parseBinaryExpression(&Parser::parseAndExpression, { Token::Operator::BoolXor });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseOrExpression() {
+    return parseBinaryExpression(&Parser::parseBoolXorExpression, { Token::Operator::BoolOr });
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseTernaryExpression() {
+    auto condition = parseOrExpression();
+
+    while (condition != nullptr && consume(tokens::Operator::QuestionMark)) {
+        auto trueBranch = parseOrExpression();
+        if (trueBranch == nullptr)
+            return nullptr;
+
+        if (!consume(tokens::Operator::Colon))
+            return error("Expected ':' in ternary expression");
+
+        auto falseBranch = parseOrExpression();
+        if (falseBranch == nullptr)
+            return nullptr;
+
+        condition = create<ast::AstNodeTernaryOperator>(std::move(condition), std::move(trueBranch), std::move(falseBranch));
+    }
+
+    return condition;
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseExpression() {
+    // nested parentheses and call arguments recurse through here, unary operators are counted separately
+    if (m_depth >= maxNestingDepth)
+        return error("Expression nested too deeply");
+
+    m_depth++;
+    auto expression = parseTernaryExpression();
+    m_depth--;
+
+    return expression;
+}
+
+std::shared_ptr<ast::AstNode> Parser::parseStatement(const StatementRange &statement) {
+    m_begin = statement.begin;
+    m_current = statement.begin;
+    m_end = statement.end;
+    m_depth = 0;
+
+    // empty statement
+    if (consume(tokens::Separator::Semicolon))
+        return nullptr;
+
+    auto expression = parseExpression();
+    if (expression == nullptr)
+        return nullptr;
+
+    if (!consume(tokens::Separator::Semicolon))
+        return error("Expected ';'");
+
+    return expression;
+}
+
+void Parser::parseStatements(std::span<const StatementRange> statements) {
+    // a failing statement only reports its first error, parsing resumes at the next statement boundary
+    for (const auto &statement : statements) {
+        auto node = parseStatement(statement);
+        if (node != nullptr)
+            m_ast.push_back(std::move(node));
+    }
+}
+
+static Results<std::vector<std::shared_ptr<ast::AstNode>>> makeResult(std::vector<std::shared_ptr<ast::AstNode>> ast,
+                                                                     const std::vector<ParserError> &parserErrors) {
+    if (parserErrors.empty())
+        return ast;
+
+    std::vector<Error> errors;
+    errors.reserve(parserErrors.size());
+    for (const auto &error : parserErrors) {
+        errors.emplace_back(fmt::format("{}:{}: {}", error.location().line, error.location().column, error.get_message()));
+    }
+
+    return errors;
+}
+
+Results<std::vector<std::shared_ptr<ast::AstNode>>> Parser::parse(const std::vector<Token> &tokens) {
+    m_errors.clear();
+    m_ast.clear();
+    if (m_nodeTable != nullptr)
+        m_nodeTable->clear();
+
+    auto statements = findStatementBoundaries(tokens);
+    parseStatements(statements);
+
+    return makeResult(std::move(m_ast), m_errors);
+}
+
+Results<std::vector<std::shared_ptr<ast::AstNode>>> Parser::parseParallel(const std::vector<Token> &tokens, u32 threadCount) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    auto statements = findStatementBoundaries(tokens);
+    if (threadCount == 1 || statements.size() < 2)
+        return parse(tokens);
+
+    // split the statements into contiguous chunks of roughly equal token count
+    std::vector<std::span<const StatementRange>> chunks;
+    size_t tokensPerChunk = tokens.size() / threadCount + 1;
+    size_t chunkBegin = 0, chunkTokens = 0;
+    for (size_t i = 0; i < statements.size(); ++i) {
+        chunkTokens += std::distance(statements[i].begin, statements[i].end);
+        if (chunkTokens >= tokensPerChunk || i + 1 == statements.size()) {
+            chunks.emplace_back(statements.data() + chunkBegin, i + 1 - chunkBegin);
+            chunkBegin = i + 1;
+            chunkTokens = 0;
+        }
+    }
+
+    if (m_nodeTable != nullptr)
+        m_nodeTable->clear();
+
+    // every worker owns its own parser, only the node table is shared between threads
+    std::vector<Parser> parsers(chunks.size());
+    for (auto &parser : parsers) {
+        parser.m_typeNames = m_typeNames;
+        parser.m_nodeTable = m_nodeTable;
+    }
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            workers.emplace_back([&parser = parsers[i], chunk = chunks[i]] {
+                parser.parseStatements(chunk);
+            });
+        }
+    }
+
+    // merge in source order
+    m_errors.clear();
+    m_ast.clear();
+    for (auto &parser : parsers) {
+        m_ast.insert(m_ast.end(), std::make_move_iterator(parser.m_ast.begin()), std::make_move_iterator(parser.m_ast.end()));
+        m_errors.insert(m_errors.end(), parser.m_errors.begin(), parser.m_errors.end());
+    }
+
+    return makeResult(std::move(m_ast), m_errors);
+}
@@ -1,4 +1,5 @@
 #include <parser/token.hpp>
+#include <common/character_util.hpp>
 
 using namespace parser;
 
@@ -18,4 +19,38 @@ std::map<char, Token>& Token::separators() {
     static std::map<char, Token> s_separators;
 
     return s_separators;
-}
\ No newline at end of file
+}
+
+std::string Token::String::decode() const {
+    if (!m_hasEscapes)
+        return std::string(m_raw);
+
+    std::string result;
+    result.reserve(m_raw.size());
+
+    size_t cursor = 0;
+    while (cursor < m_raw.size()) {
+        // copy everything up to the next escape sequence in one go
+        size_t escape = m_raw.find('\\', cursor);
+        if (escape == std::string_view::npos) {
+            result.append(m_raw.substr(cursor));
+            break;
+        }
+
+        result.append(m_raw.substr(cursor, escape - cursor));
+        cursor = escape;
+
+        // the lexer already validated all escape sequences
+        auto character = util::parse_escape_sequence(m_raw, cursor);
+        result += character.value_or('\\');
+    }
+
+    return result;
+}
+
+bool Token::String::operator==(const Token::String &other) const {
+    if (!m_hasEscapes && !other.m_hasEscapes)
+        return m_raw == other.m_raw;
+
+    return decode() == other.decode();
+}
@@ -0,0 +1,67 @@
+#include <parser/lexer.h>
+#include <parser/parser.h>
+#include <evaluator/evaluator.h>
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+using namespace parser;
+using namespace evaluator;
+
+namespace {
+
+    u32 s_failures = 0;
+
+    void expect(bool condition, std::string_view description) {
+        if (!condition) {
+            fmt::print("FAIL: {}\n", description);
+            s_failures++;
+        }
+    }
+
+    util::ResultOk<Token::Literal> evaluate(const std::string &source, const Bindings &bindings) {
+        Lexer lexer;
+        auto result = Parser().parse(lexer.lex(source + ";").unwrap());
+        if (result.is_err() || result.unwrap().size() != 1)
+            return util::Error(fmt::format("Could not parse {}", source));
+
+        return Evaluator().evaluate(result.unwrap()[0], bindings);
+    }
+
+}
+
+int main() {
+    // float to integer casts accept exactly the values representable in 64 bits
+    {
+        Bindings bindings;
+        auto x = bindings.declare("x", ValueType::Float);
+
+        bindings.set(x, -0x1p63);
+        auto minimum = evaluate("(s64)x", bindings);
+        expect(minimum.is_ok() && std::get<s64>(minimum.unwrap()) == std::numeric_limits<s64>::min(), "(s64)-2^63 is the s64 minimum");
+
+        bindings.set(x, std::nextafter(-0x1p63, -INFINITY));
+        expect(evaluate("(s64)x", bindings).is_err(), "values below -2^63 are out of range");
+
+        bindings.set(x, std::nextafter(0x1p64, 0.0));
+        auto maximum = evaluate("(u64)x", bindings);
+        expect(maximum.is_ok() && std::get<u64>(maximum.unwrap()) == 0xFFFFFFFFFFFFF800, "the largest float below 2^64 fits a u64");
+
+        bindings.set(x, 0x1p64);
+        expect(evaluate("(u64)x", bindings).is_err(), "2^64 is out of range");
+
+        bindings.set(x, f64(NAN));
+        expect(evaluate("(s32)x", bindings).is_err(), "NaN is out of range");
+    }
+
+    if (s_failures != 0) {
+        fmt::print("{} failures\n", s_failures);
+        return 1;
+    }
+
+    fmt::print("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include <parser/lexer.h>
+#include <parser/parser.h>
+#include <evaluator/evaluator.h>
+#include <evaluator/jit.h>
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace parser;
+using namespace evaluator;
+
+namespace {
+
+    struct Variables {
+        Bindings bindings;
+        u32 a, b, c, x, y, u, v;
+
+        Variables() {
+            a = bindings.declare("a", ValueType::Signed);
+            b = bindings.declare("b", ValueType::Signed);
+            c = bindings.declare("c", ValueType::Signed);
+            x = bindings.declare("x", ValueType::Float);
+            y = bindings.declare("y", ValueType::Float);
+            u = bindings.declare("u", ValueType::Unsigned);
+            v = bindings.declare("v", ValueType::Unsigned);
+        }
+    };
+
+    std::shared_ptr<ast::AstNode> parseExpression(const std::string &source) {
+        Lexer lexer;
+        auto result = Parser().parse(lexer.lex(source + ";").unwrap());
+        if (result.is_err() || result.unwrap().size() != 1)
+            return nullptr;
+
+        return result.unwrap()[0];
+    }
+
+    std::string describe(const util::ResultOk<Token::Literal> &result) {
+        if (result.is_err())
+            return fmt::format("error '{}'", result.unwrap_err().get_message());
+
+        const auto &value = result.unwrap();
+        if (auto f = std::get_if<f64>(&value))
+            return fmt::format("f64 {}", *f);
+        else if (auto s = std::get_if<s64>(&value))
+            return fmt::format("s64 {}", *s);
+        else
+            return fmt::format("u64 {}", std::get<u64>(value));
+    }
+
+    bool identical(const util::ResultOk<Token::Literal> &left, const util::ResultOk<Token::Literal> &right) {
+        if (left.is_err() || right.is_err())
+            return left.is_err() && right.is_err() && left.unwrap_err().get_message() == right.unwrap_err().get_message();
+
+        const auto &a = left.unwrap(), &b = right.unwrap();
+        if (a.index() != b.index())
+            return false;
+
+        // floats have to match bit for bit, any NaN matches any NaN
+        if (auto f = std::get_if<f64>(&a)) {
+            f64 g = std::get<f64>(b);
+            return (std::isnan(*f) && std::isnan(g)) || std::memcmp(f, &g, sizeof(f64)) == 0;
+        }
+
+        if (auto s = std::get_if<s64>(&a))
+            return *s == std::get<s64>(b);
+
+        return std::get<u64>(a) == std::get<u64>(b);
+    }
+
+    class Generator {
+    public:
+        explicit Generator(u64 seed) : m_random(seed) { }
+
+        std::string expression(u32 depth) {
+            constexpr const char *binaryOperators[] = {
+                "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^", "&&", "||", "^^", "==", "!=", "<", ">", "<=", ">="
+            };
+            constexpr const char *unaryOperators[] = { "-", "~", "!", "+" };
+
+            u32 kind = pick(10);
+            if (depth == 0 || kind < 2)
+                return leaf();
+            if (kind == 2)
+                return fmt::format("{}({})", unaryOperators[pick(4)], expression(depth - 1));
+            if (kind == 3)
+                return fmt::format("({} ? {} : {})", expression(depth - 1), expression(depth - 1), expression(depth - 1));
+
+            return fmt::format("({} {} {})", expression(depth - 1), binaryOperators[pick(19)], expression(depth - 1));
+        }
+
+        void randomize(Variables &variables) {
+            constexpr s64 signedValues[] = { 0, 1, -1, std::numeric_limits<s64>::min(), std::numeric_limits<s64>::max(), 3, -7, 64, 65 };
+            constexpr f64 floatValues[] = { 0.0, -0.0, 1.5, -2.25, NAN, INFINITY, 1e300, 9.3e18 };
+            constexpr u64 unsignedValues[] = { 0, 1, ~0ULL, 1ULL << 63, 5, (1ULL << 63) + 1025 };
+
+            variables.bindings.set(variables.a, signedValues[pick(std::size(signedValues))]);
+            variables.bindings.set(variables.b, s64(m_random()));
+            variables.bindings.set(variables.c, signedValues[pick(std::size(signedValues))]);
+            variables.bindings.set(variables.x, floatValues[pick(std::size(floatValues))]);
+            variables.bindings.set(variables.y, f64(s64(m_random())) / 7.0);
+            variables.bindings.set(variables.u, unsignedValues[pick(std::size(unsignedValues))]);
+            variables.bindings.set(variables.v, u64(m_random()));
+        }
+
+    private:
+        u32 pick(u64 count) {
+            return u32(m_random() % count);
+        }
+
+        std::string leaf() {
+            constexpr const char *names[] = { "a", "b", "c", "x", "y", "u", "v" };
+
+            switch (pick(6)) {
+                case 0:
+                    return std::to_string(pick(20));
+                case 1:
+                    return std::to_string(pick(100)) + "u";
+                case 2:
+                    return std::to_string(pick(100)) + ".5";
+                default:
+                    return names[pick(7)];
+            }
+        }
+
+        std::mt19937_64 m_random;
+    };
+
+    u32 s_failures = 0;
+
+    /**
+     * Evaluates the expression with the interpreter and natively and reports any difference.
+     */
+    void check(const std::string &source, const Variables &variables, bool requireNative) {
+        auto expression = parseExpression(source);
+        if (expression == nullptr) {
+            fmt::print("FAIL: could not parse {}\n", source);
+            s_failures++;
+            return;
+        }
+
+        CompiledExpression compiled(expression, variables.bindings);
+        if (requireNative && !compiled.isNative()) {
+            fmt::print("FAIL: {} was not compiled natively\n", source);
+            s_failures++;
+            return;
+        }
+
+        auto interpreted = Evaluator().evaluate(expression, variables.bindings);
+        auto native = compiled.evaluate(variables.bindings);
+        if (!identical(interpreted, native)) {
+            fmt::print("FAIL: {}\n  interpreter: {}\n  jit:         {}\n", source, describe(interpreted), describe(native));
+            s_failures++;
+        }
+    }
+
+    void expect(bool condition, std::string_view description) {
+        if (!condition) {
+            fmt::print("FAIL: {}\n", description);
+            s_failures++;
+        }
+    }
+
+    std::string nest(const std::string &leaf, u32 depth, const std::function<std::string(const std::string &, u32)> &wrap) {
+        std::string expression = leaf;
+        for (u32 i = 0; i < depth; ++i)
+            expression = wrap(expression, i);
+
+        return expression;
+    }
+
+}
+
+int main() {
+    Variables variables;
+    Generator generator(0xB00757A9);
+
+    // random expressions over every operator and value type
+    u32 native = 0;
+    constexpr u32 expressionCount = 10000;
+    for (u32 i = 0; i < expressionCount; ++i) {
+        auto source = generator.expression(1 + i % 7);
+        auto expression = parseExpression(source);
+        if (expression == nullptr) {
+            fmt::print("FAIL: could not parse {}\n", source);
+            s_failures++;
+            continue;
+        }
+
+        CompiledExpression compiled(expression, variables.bindings);
+        native += compiled.isNative();
+
+        for (int run = 0; run < 5; ++run) {
+            generator.randomize(variables);
+
+            auto interpreted = Evaluator().evaluate(expression, variables.bindings);
+            auto result = compiled.evaluate(variables.bindings);
+            if (!identical(interpreted, result)) {
+                fmt::print("FAIL: {}\n  interpreter: {}\n  jit:         {}\n", source, describe(interpreted), describe(result));
+                s_failures++;
+            }
+        }
+    }
+
+    if (native < expressionCount / 4) {
+        fmt::print("FAIL: only {} of {} random expressions were compiled natively\n", native, expressionCount);
+        s_failures++;
+    }
+
+    // more live values than allocatable registers forces spilling
+    auto integerSpills = nest("a", 30, [](const std::string &inner, u32 i) {
+        return fmt::format("({} + (b * (c - ({}))))", i, inner);
+    });
+    auto floatSpills = nest("x", 30, [](const std::string &inner, u32) {
+        return fmt::format("(y + (x * ({})))", inner);
+    });
+    auto mixedSpills = nest("u", 20, [](const std::string &inner, u32 i) {
+        return fmt::format("(v ^ ({} + (a << {}) - ({}u | ({}))))", i, i % 64, i, inner);
+    });
+
+    for (int run = 0; run < 20; ++run) {
+        generator.randomize(variables);
+        check(integerSpills, variables, true);
+        check(floatSpills, variables, true);
+        check(mixedSpills, variables, true);
+    }
+
+    // NaN compares false except for !=, and is truthy
+    variables.bindings.set(variables.x, f64(NAN));
+    variables.bindings.set(variables.y, 1.0);
+    for (auto source : { "x < y", "x > y", "x <= y", "x >= y", "x == y", "x != y", "x == x", "x != x", "!x", "x && 1", "x ? 1 : 2" })
+        check(source, variables, true);
+
+    // s64 minimum / -1 wraps around instead of trapping
+    variables.bindings.set(variables.a, std::numeric_limits<s64>::min());
+    variables.bindings.set(variables.b, s64(-1));
+    for (auto source : { "a / b", "a % b", "a / -1", "-a", "a * b" })
+        check(source, variables, true);
+
+    // division by zero is an error, short circuiting skips it
+    variables.bindings.set(variables.c, s64(0));
+    variables.bindings.set(variables.u, u64(0));
+    for (auto source : { "a / c", "a % c", "5u / u", "5u % u", "c && (a / c)", "1 || (a / c)", "c ? a / c : 7" })
+        check(source, variables, true);
+
+    // native code only runs on bindings sharing the layout it was compiled against
+    {
+        Bindings layout;
+        auto first = layout.declare("a", ValueType::Signed);
+        auto second = layout.declare("b", ValueType::Signed);
+        layout.set(first, s64(7));
+        layout.set(second, s64(2));
+
+        auto expression = parseExpression("a - b");
+        CompiledExpression compiled(expression, layout);
+
+        Bindings copy = layout;
+        Bindings extended = layout;
+        extended.declare("c", ValueType::Float);
+
+        Bindings swapped;
+        swapped.set(swapped.declare("b", ValueType::Signed), s64(2));
+        swapped.set(swapped.declare("a", ValueType::Signed), s64(7));
+
+        expect(copy.hasLayout(layout.layout()), "copies share the layout");
+        expect(!extended.hasLayout(layout.layout()) && layout.hasLayout(copy.layout()), "declaring on a copy leaves the original layout alone");
+        expect(!swapped.hasLayout(layout.layout()), "independently declared bindings have their own layout");
+
+        for (const auto *bindings : { &layout, &copy, &extended, &swapped }) {
+            auto result = compiled.evaluate(*bindings);
+            expect(result.is_ok() && std::get<s64>(result.unwrap()) == 5, "every layout evaluates a - b correctly");
+        }
+    }
+
+    if (s_failures != 0) {
+        fmt::print("{} failures\n", s_failures);
+        return 1;
+    }
+
+    fmt::print("all checks passed, {} of {} random expressions compiled natively\n", native, expressionCount);
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include <parser/lexer.h>
+#include <parser/parser.h>
+#include <parser/ast/ast_node_binary_operator.hpp>
+#include <parser/ast/ast_node_literal.hpp>
+
+#include <fmt/format.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace parser;
+
+namespace {
+
+    u32 s_failures = 0;
+
+    void expect(bool condition, std::string_view description) {
+        if (!condition) {
+            fmt::print("FAIL: {}\n", description);
+            s_failures++;
+        }
+    }
+
+    /**
+     * Parses `source` and returns the number of reported errors, or 0 if it parsed.
+     */
+    size_t countErrors(Parser &parser, const std::string &source) {
+        Lexer lexer;
+        auto tokens = lexer.lex(source);
+        if (tokens.is_err())
+            return tokens.unwrap_err().size();
+
+        auto result = parser.parse(tokens.unwrap());
+        return result.is_err() ? result.unwrap_err().size() : 0;
+    }
+
+    /**
+     * Lexes a single string literal, `lexer` has to outlive the result.
+     */
+    std::optional<Token::String> lexString(Lexer &lexer, const std::string &source) {
+        auto tokens = lexer.lex(source);
+        if (tokens.is_err() || tokens.unwrap().size() != 1)
+            return std::nullopt;
+
+        auto literal = std::get_if<Token::Literal>(&tokens.unwrap()[0].value());
+        if (literal == nullptr || !std::holds_alternative<Token::String>(*literal))
+            return std::nullopt;
+
+        return std::get<Token::String>(*literal);
+    }
+
+    constexpr u32 errorInterval = 37;
+
+    /**
+     * Many statements with errors scattered between them, so every chunk of a parallel parse sees some.
+     */
+    std::string generateStatements(u32 count, bool withErrors) {
+        constexpr const char *valid[] = {
+            "a.b.c + f(x, 3) * (u32)y;",
+            "x << 3 & mask;",
+            "\"text\" == name ? -1 : ~flags;",
+            "f(g(a.b), (s8)(c - 1), !d) || e ^^ 2;",
+            "a.b.c;",
+        };
+        constexpr const char *invalid[] = { "c +;", "f(.x);", "(a;", "a ? b;", "g(1,);" };
+
+        std::string source;
+        for (u32 i = 0; i < count; ++i) {
+            source += withErrors && i % errorInterval == 11 ? invalid[i % std::size(invalid)] : valid[i % std::size(valid)];
+            source += '\n';
+        }
+
+        return source;
+    }
+
+    std::vector<std::string> errorMessages(const util::Results<std::vector<std::shared_ptr<ast::AstNode>>> &result) {
+        std::vector<std::string> messages;
+        if (result.is_err()) {
+            for (const auto &error : result.unwrap_err())
+                messages.push_back(error.get_message());
+        }
+
+        return messages;
+    }
+
+}
+
+int main() {
+    // string literals are kept as spans into the source and only decoded on demand
+    {
+        Lexer lexer;
+
+        auto plain = lexString(lexer, "\"plain text\"");
+        expect(plain.has_value() && !plain->hasEscapes(), "plain literal has no escapes");
+        if (plain.has_value()) {
+            expect(plain->view() == "plain text" && plain->view().data() == plain->raw().data(), "plain literal is a zero-copy view");
+            expect(plain->decode() == "plain text", "plain literal decodes to itself");
+        }
+
+        auto empty = lexString(lexer, "\"\"");
+        expect(empty.has_value() && !empty->hasEscapes() && empty->decode().empty(), "empty literal decodes to nothing");
+
+        const std::pair<std::string, std::string> escaped[] = {
+            { R"("a\n\tb")", "a\n\tb" },
+            { R"("\\\"")", "\\\"" },
+            { R"("\x41\x42c")", "ABc" },
+            { R"("\u0041z")", "Az" },
+            { R"("x\\y\"z\0w")", std::string("x\\y\"z\0w", 7) },
+            { R"("\a\b\f\r\'end")", "\a\b\f\r'end" },
+        };
+
+        for (const auto &[source, expected] : escaped) {
+            auto string = lexString(lexer, source);
+            expect(string.has_value() && string->hasEscapes(), fmt::format("{} has escapes", source));
+            if (string.has_value()) {
+                expect(string->raw() == std::string_view(source).substr(1, source.size() - 2), fmt::format("{} keeps its raw spelling", source));
+                expect(string->decode() == expected, fmt::format("{} decodes correctly", source));
+            }
+        }
+    }
+
+    // string tokens compare by value, whatever their spelling
+    {
+        Lexer first, second;
+        auto escaped = lexString(first, "\"\\x41\\n\"");
+        auto plain = lexString(second, "\"A\n\"");
+        expect(escaped.has_value() && plain.has_value() && *escaped == *plain, "escaped and plain spellings are equal");
+    }
+
+    // whitespace separates tokens without being reported
+    {
+        Lexer lexer;
+        auto tokens = lexer.lex(" a +\tb\n;\r\n");
+        expect(tokens.is_ok() && tokens.unwrap().size() == 4, "whitespace is skipped");
+    }
+
+    // lexer errors are returned, and lexing resumes behind the broken literal
+    {
+        Lexer lexer;
+        auto tokens = lexer.lex("\"abc\\q\" + 1;");
+        expect(tokens.is_err() && tokens.unwrap_err().size() == 1, "an unknown escape sequence is a single error");
+
+        tokens = lexer.lex("\"\\x4\" + \"\\u12\";");
+        expect(tokens.is_err() && tokens.unwrap_err().size() == 2, "every truncated escape sequence is reported");
+
+        tokens = lexer.lex("1 + \"abc");
+        expect(tokens.is_err() && tokens.unwrap_err().size() == 1, "an unterminated string literal is an error");
+
+        tokens = lexer.lex("\"abc\";");
+        expect(tokens.is_ok(), "errors do not carry over to the next source");
+
+        Parser parser;
+        expect(countErrors(parser, "\"abc\\q\" + 1;") == 1, "lexer errors are reported to the caller");
+    }
+
+    // a failed operand must not be wrapped into member access or call nodes
+    for (bool hashConsing : { false, true }) {
+        Parser parser;
+        if (hashConsing)
+            parser.enableHashConsing();
+
+        expect(countErrors(parser, "f(.x);") == 1, "f(.x); reports a single error");
+        expect(countErrors(parser, "f(a, .x).y;") == 1, "f(a, .x).y; reports a single error");
+        expect(countErrors(parser, "(.x).y;") == 1, "(.x).y; reports a single error");
+        expect(countErrors(parser, "f(a).b.c;") == 0, "f(a).b.c; parses");
+    }
+
+    // an unclosed bracket must not swallow the statements after it
+    {
+        Lexer lexer;
+        auto tokens = lexer.lex("(a; b; f(.x); c +; d;").unwrap();
+        expect(Parser::findStatementBoundaries(tokens).size() == 5, "every semicolon ends a statement");
+
+        Parser parser;
+        expect(countErrors(parser, "(a; b; f(.x); c +; d;") == 3, "errors after an unclosed bracket are reported");
+    }
+
+    // structurally identical subtrees collapse into one node
+    {
+        Parser parser;
+        parser.enableHashConsing();
+
+        Lexer lexer;
+        auto result = parser.parse(lexer.lex("a.b.c; a.b.c; x << 3 & mask; x << 3 & mask; (x << 3) + (x << 3);").unwrap());
+        expect(result.is_ok() && result.unwrap().size() == 5, "shared subtrees parse");
+
+        if (result.is_ok() && result.unwrap().size() == 5) {
+            const auto &nodes = result.unwrap();
+            expect(nodes[0] == nodes[1], "a.b.c is shared between statements");
+            expect(nodes[2] == nodes[3], "x << 3 & mask is shared between statements");
+
+            auto sum = std::dynamic_pointer_cast<ast::AstNodeBinaryOperator>(nodes[4]);
+            auto mask = std::dynamic_pointer_cast<ast::AstNodeBinaryOperator>(nodes[2]);
+            expect(sum != nullptr && sum->left() == sum->right(), "x << 3 is shared within a statement");
+            expect(sum != nullptr && mask != nullptr && sum->left() == mask->left(), "x << 3 is shared with a larger subtree");
+        }
+
+        // a, a.b, a.b.c, x, 3, x << 3, mask, & and +
+        expect(parser.nodeTable()->size() == 9, "node table holds every unique subtree once");
+    }
+
+    {
+        std::string source;
+        for (u32 i = 0; i < 2000; ++i)
+            source += fmt::format("(x << 3 & mask) + a.b.c * f(1, 2.5, \"s\\n\") - {};\n", i % 8);
+
+        Lexer lexer;
+        auto tokens = lexer.lex(source).unwrap();
+
+        Parser plain, shared;
+        shared.enableHashConsing();
+        auto plainNodes = plain.parse(tokens).unwrap();
+        auto sharedNodes = shared.parse(tokens).unwrap();
+
+        // 14 nodes are common to every statement, each new suffix adds a `-` node and,
+        // unless it is the 1 or 3 already in the statement, a literal
+        expect(shared.nodeTable()->size() == 28, "2000 statements share 28 unique nodes");
+        expect(sharedNodes[0] == sharedNodes[8] && sharedNodes[0] != sharedNodes[1], "statements with the same suffix are one node");
+
+        bool sameHashes = plainNodes.size() == sharedNodes.size();
+        for (size_t i = 0; sameHashes && i < plainNodes.size(); ++i)
+            sameHashes = plainNodes[i]->hash() == sharedNodes[i]->hash();
+
+        expect(sameHashes, "hashes do not depend on hash-consing");
+    }
+
+    // a parallel parse reports the same nodes and errors as a sequential one
+    {
+        Lexer lexer, validLexer;
+        auto tokens = lexer.lex(generateStatements(2000, true)).unwrap();
+        auto validTokens = validLexer.lex(generateStatements(2000, false)).unwrap();
+
+        for (bool hashConsing : { false, true }) {
+            Parser sequential;
+            if (hashConsing)
+                sequential.enableHashConsing();
+
+            auto expected = sequential.parse(tokens);
+            auto expectedErrors = errorMessages(expected);
+            expect(expectedErrors.size() == (2000 + errorInterval - 12) / errorInterval, "generated input reports every error");
+
+            // nodes are only returned when there are no errors
+            auto expectedNodes = sequential.parse(validTokens).unwrap();
+            auto expectedTableSize = hashConsing ? sequential.nodeTable()->size() : 0;
+
+            for (u32 threadCount : { 1u, 2u, 3u, 4u, 7u, 16u }) {
+                Parser parallel;
+                if (hashConsing)
+                    parallel.enableHashConsing();
+
+                auto description = fmt::format("{} threads{}", threadCount, hashConsing ? " with hash-consing" : "");
+                expect(errorMessages(parallel.parseParallel(tokens, threadCount)) == expectedErrors,
+                       fmt::format("errors match the sequential parse on {}", description));
+
+                auto nodes = parallel.parseParallel(validTokens, threadCount).unwrap();
+                bool identical = nodes.size() == expectedNodes.size();
+                for (size_t i = 0; identical && i < nodes.size(); ++i)
+                    identical = nodes[i]->hash() == expectedNodes[i]->hash();
+
+                expect(identical, fmt::format("nodes match the sequential parse on {}", description));
+                if (hashConsing)
+                    expect(parallel.nodeTable()->size() == expectedTableSize,
+                           fmt::format("node table matches the sequential parse on {}", description));
+            }
+        }
+    }
+
+    // interned string literals must never outlive the lexer that owns their characters
+    {
+        Parser parser;
+        parser.enableHashConsing();
+
+        std::optional<Lexer> first(std::in_place);
+        expect(parser.parse(first->lex("\"hello\";").unwrap()).is_ok(), "first source parses");
+        first.reset();
+
+        Lexer second;
+        auto tokens = second.lex("\"hello\";").unwrap();
+        auto result = parser.parse(tokens);
+        expect(result.is_ok() && result.unwrap().size() == 1, "second source parses");
+
+        if (result.is_ok() && result.unwrap().size() == 1) {
+            auto literal = std::dynamic_pointer_cast<ast::AstNodeLiteral>(result.unwrap()[0]);
+            auto expected = std::get<Token::String>(std::get<Token::Literal>(tokens[0].value())).raw();
+            expect(literal != nullptr && std::get<Token::String>(literal->literal()).raw().data() == expected.data(),
+                   "interned literal refers to the current lexer");
+        }
+    }
+
+    // escaped literals are interned by spelling without being decoded
+    {
+        Parser parser;
+        parser.enableHashConsing();
+
+        Lexer lexer;
+        auto result = parser.parse(lexer.lex("\"a\\n\"; \"a\\n\"; \"\\x41\"; \"A\";").unwrap());
+        expect(result.is_ok() && result.unwrap().size() == 4, "escaped literals parse");
+
+        if (result.is_ok() && result.unwrap().size() == 4) {
+            const auto &nodes = result.unwrap();
+            expect(nodes[0] == nodes[1], "identical escaped literals share a node");
+            expect(nodes[2] != nodes[3], "differently spelled literals stay distinct");
+        }
+    }
+
+    if (s_failures != 0) {
+        fmt::print("{} failures\n", s_failures);
+        return 1;
+    }
+
+    fmt::print("all checks passed\n");
+    return 0;
+}